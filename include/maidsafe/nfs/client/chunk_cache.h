@@ -0,0 +1,115 @@
+/*  Copyright 2013 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#ifndef MAIDSAFE_NFS_CLIENT_CHUNK_CACHE_H_
+#define MAIDSAFE_NFS_CLIENT_CHUNK_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "boost/filesystem/path.hpp"
+#include "boost/optional/optional.hpp"
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4702)
+#endif
+#include "boost/thread/future.hpp"
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include "maidsafe/common/types.h"
+#include "maidsafe/common/data_types/immutable_data.h"
+
+namespace maidsafe {
+
+namespace nfs_client {
+
+// Bounded least-recently-used cache of ImmutableData chunks fetched by a client.  Since these are
+// content-addressed, a cached copy can never be stale.  Chunks evicted from memory move to the
+// optional disk tier, and chunks read from disk move back to memory.  Chunks larger than the
+// memory limit go straight to disk (or aren't cached if there is no disk tier).  Disk errors are
+// logged and the affected chunk dropped, so the cache never causes a Get to fail.  Chunks are held
+// in memory as ImmutableData, so memory hits aren't revalidated, and disk reads (which are
+// validated) are done without holding the lock.
+class ChunkCache {
+ public:
+  explicit ChunkCache(MemoryUsage max_memory_usage);
+  // Files are written to (and only ever removed from) 'disk_path', which is created if necessary.
+  // Files left by a previous instance are not reused.
+  ChunkCache(MemoryUsage max_memory_usage, const boost::filesystem::path& disk_path,
+             DiskUsage max_disk_usage);
+  ~ChunkCache();
+
+  boost::optional<ImmutableData> Get(const ImmutableData::Name& name);
+  void Store(const ImmutableData& data);
+
+ private:
+  typedef std::list<std::string> LruList;  // Keys, most recently used first.
+  struct MemoryEntry {
+    ImmutableData data;
+    LruList::iterator lru_position;
+  };
+  struct DiskEntry {
+    uint64_t size;
+    LruList::iterator lru_position;
+  };
+
+  ChunkCache(const ChunkCache&);
+  ChunkCache(ChunkCache&&);
+  ChunkCache& operator=(ChunkCache);
+
+  void StoreInMemory(const std::string& key, ImmutableData data);
+  void StoreOnDisk(const std::string& key, const NonEmptyString& content);
+  void RemoveFromDisk(const std::string& key);
+  boost::filesystem::path FilePath(const std::string& key) const;
+
+  const uint64_t kMaxMemoryUsage_, kMaxDiskUsage_;
+  const boost::filesystem::path kDiskPath_;
+  uint64_t memory_usage_, disk_usage_;
+  LruList memory_lru_, disk_lru_;
+  std::unordered_map<std::string, MemoryEntry> memory_entries_;
+  std::unordered_map<std::string, DiskEntry> disk_entries_;
+  std::mutex mutex_;
+};
+
+// Overloads used by the Get path, which is templated on the data type: only ImmutableData is
+// cached.
+template <typename DataName>
+bool GetFromChunkCache(ChunkCache& /*chunk_cache*/, const DataName& /*data_name*/,
+                       boost::promise<typename DataName::data_type>& /*promise*/) {
+  return false;
+}
+
+bool GetFromChunkCache(ChunkCache& chunk_cache, const ImmutableData::Name& data_name,
+                       boost::promise<ImmutableData>& promise);
+
+template <typename Data>
+void AddToChunkCache(ChunkCache& /*chunk_cache*/, const Data& /*data*/) {}
+
+void AddToChunkCache(ChunkCache& chunk_cache, const ImmutableData& data);
+
+}  // namespace nfs_client
+
+}  // namespace maidsafe
+
+#endif  // MAIDSAFE_NFS_CLIENT_CHUNK_CACHE_H_
@@ -19,17 +19,26 @@
 #ifndef MAIDSAFE_NFS_CLIENT_CLIENT_UTILS_H_
 #define MAIDSAFE_NFS_CLIENT_CLIENT_UTILS_H_
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <utility>
 #include <vector>
 
 #include "boost/exception/all.hpp"
+#include "boost/optional/optional.hpp"
 #include "boost/thread/future.hpp"
 
+#include "maidsafe/common/error.h"
+#include "maidsafe/common/data_types/data_type_values.h"
 #include "maidsafe/common/data_types/structured_data_versions.h"
 
 #include "maidsafe/routing/timer.h"
 
 #include "maidsafe/nfs/utils.h"
+#include "maidsafe/nfs/client/chunk_cache.h"
 #include "maidsafe/nfs/client/messages.h"
 #include "maidsafe/nfs/client/maid_node_dispatcher.h"
 
@@ -37,21 +46,83 @@ namespace maidsafe {
 
 namespace nfs_client {
 
+// One page of a branch, as returned by the paginated GetBranch.
+struct BranchPage {
+  std::vector<StructuredDataVersions::VersionName> versions;
+  // Set if the branch continues beyond 'versions'; pass it as the start of the next page.
+  boost::optional<StructuredDataVersions::VersionName> next_page_start;
+};
+
+// nfs_vault::DataName's operator< only compares raw names, so containers which must keep apart data
+// of different types sharing a raw name are keyed on this instead.
+typedef std::pair<DataTagValue, std::string> TypedDataName;
+
+inline TypedDataName GetTypedDataName(const nfs_vault::DataName& name) {
+  return std::make_pair(name.type, name.raw_name.string());
+}
+
+// Keeps the object built when a Get's response is validated, so that it can be handed to the
+// caller rather than being rebuilt (and its content rehashed) from the response.  Only identical
+// content validates against a given name, so the first object to be validated is kept.
+template <typename Data>
+class ValidatedData {
+ public:
+  ValidatedData() : mutex_(), data_() {}
+
+  // Returns true if 'content' holds the data named 'name', in which case the data is kept.
+  bool Validate(const typename Data::Name& name, const nfs_vault::Content& content);
+  // Returns a copy of the kept data.
+  boost::optional<Data> data() const;
+  // Moves the kept data out, leaving none.  Only the last user of the data should call this.
+  boost::optional<Data> TakeData();
+
+ private:
+  ValidatedData(const ValidatedData&);
+  ValidatedData(ValidatedData&&);
+  ValidatedData& operator=(ValidatedData);
+
+  mutable std::mutex mutex_;
+  boost::optional<Data> data_;
+};
+
 template <typename Data>
 struct HandleGetResult {
-  explicit HandleGetResult(std::shared_ptr<boost::promise<Data>> promise_in)
-      : promise(std::move(promise_in)) {}
+  // If 'chunk_cache_in' is non-null, fetched ImmutableData is added to it.  If 'validated_data_in'
+  // holds data, that is passed to the promise in place of a copy rebuilt from the result; it is
+  // moved out if 'take_validated_data_in' is true, otherwise it is copied.
+  explicit HandleGetResult(std::shared_ptr<boost::promise<Data>> promise_in,
+                           std::shared_ptr<ChunkCache> chunk_cache_in = nullptr,
+                           std::shared_ptr<ValidatedData<Data>> validated_data_in = nullptr,
+                           bool take_validated_data_in = false)
+      : promise(std::move(promise_in)), chunk_cache(std::move(chunk_cache_in)),
+        validated_data(std::move(validated_data_in)),
+        take_validated_data(take_validated_data_in) {}
   void operator()(const DataNameAndContentOrReturnCode& result) const;
   std::shared_ptr<boost::promise<Data>> promise;
+  std::shared_ptr<ChunkCache> chunk_cache;
+  std::shared_ptr<ValidatedData<Data>> validated_data;
+  bool take_validated_data;
 };
 
+// Returns true if 'error_code' is that of a result completed by its timer rather than a response.
+inline bool IsTimeout(const std::error_code& error_code) {
+  return error_code == make_error_code(CommonErrors::defaulted) ||
+         error_code == make_error_code(NfsErrors::timed_out);
+}
+
 void HandlePutResponseResult(const ReturnCode& result,
                              std::shared_ptr<boost::promise<void>> promise);
 
+// The versions are moved out of 'result' rather than copied.
 void HandleGetVersionsOrBranchResult(
-    const StructuredDataNameAndContentOrReturnCode& result,
+    StructuredDataNameAndContentOrReturnCode result,
     std::shared_ptr<boost::promise<std::vector<StructuredDataVersions::VersionName>>> promise);
 
+// 'result' is expected to hold up to 'limit' + 1 versions; the extra one becomes the start of the
+// next page.
+void HandleGetBranchPageResult(StructuredDataNameAndContentOrReturnCode result, uint32_t limit,
+                               std::shared_ptr<boost::promise<BranchPage>> promise);
+
 void HandleCreateAccountResult(const ReturnCode& result,
                                std::shared_ptr<boost::promise<void>> promise);
 
@@ -66,6 +137,34 @@ void HandleRegisterPmidResult(const ReturnCode& result,
                               std::shared_ptr<boost::promise<void>> promise);
 
 // ==================== Implementation =============================================================
+template <typename Data>
+bool ValidatedData<Data>::Validate(const typename Data::Name& name,
+                                   const nfs_vault::Content& content) {
+  Data data(name, typename Data::serialised_type(NonEmptyString(content.data.string())));
+  if (!(data.name() == name))
+    return false;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!data_)
+    data_ = std::move(data);
+  return true;
+}
+
+template <typename Data>
+boost::optional<Data> ValidatedData<Data>::data() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return data_;
+}
+
+template <typename Data>
+boost::optional<Data> ValidatedData<Data>::TakeData() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!data_)
+    return boost::none;
+  boost::optional<Data> data(std::move(*data_));
+  data_ = boost::none;
+  return data;
+}
+
 template <typename Data>
 void HandleGetResult<Data>::operator()(const DataNameAndContentOrReturnCode& result) const {
   LOG(kVerbose) << "HandleGetResult<Data>::operator()";
@@ -77,10 +176,17 @@ void HandleGetResult<Data>::operator()(const DataNameAndContentOrReturnCode& res
       }
       LOG(kInfo) << "HandleGetResult fetched chunk has name : "
                  << HexSubstr(result.name.raw_name) << " and content : "
-                 << HexSubstr(result.content->data);
-      Data data(typename Data::Name(result.name.raw_name),
-                typename Data::serialised_type(NonEmptyString(result.content->data)));
-      promise->set_value(data);
+                 << HexSubstr(result.content->data.string());
+      boost::optional<Data> data;
+      if (validated_data)
+        data = take_validated_data ? validated_data->TakeData() : validated_data->data();
+      if (!data) {
+        data = Data(typename Data::Name(result.name.raw_name),
+                    typename Data::serialised_type(NonEmptyString(result.content->data.string())));
+      }
+      if (chunk_cache)
+        AddToChunkCache(*chunk_cache, *data);
+      promise->set_value(std::move(*data));
     } else if (result.return_code) {
       LOG(kWarning) << "HandleGetResult don't have a result but having a return code "
                     << result.return_code->value.what();
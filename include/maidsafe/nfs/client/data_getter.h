@@ -19,7 +19,9 @@
 #ifndef MAIDSAFE_NFS_CLIENT_DATA_GETTER_H_
 #define MAIDSAFE_NFS_CLIENT_DATA_GETTER_H_
 
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <vector>
 #include <mutex>
@@ -48,6 +50,7 @@ namespace nfs_client {
 class DataGetter {
  public:
   typedef boost::future<std::vector<StructuredDataVersions::VersionName>> VersionNamesFuture;
+  typedef boost::future<BranchPage> BranchPageFuture;
 
   // all_pmids_from_file should only be non-empty if TESTING is defined
   DataGetter(AsioService& asio_service, routing::Routing& routing);
@@ -66,12 +69,30 @@ class DataGetter {
                                  const std::chrono::steady_clock::duration& timeout =
                                      std::chrono::seconds(120));
 
+  // As GetVersions, but only the versions added to the tree after 'last_known_version' are
+  // returned.  An empty result means that there have been no changes.  Fails if
+  // 'last_known_version' is no longer in the tree, in which case GetVersions should be used.
+  template <typename DataName>
+  VersionNamesFuture GetVersionsSince(const DataName& data_name,
+                                      const StructuredDataVersions::VersionName& last_known_version,
+                                      const std::chrono::steady_clock::duration& timeout =
+                                          std::chrono::seconds(120));
+
   template <typename DataName>
   VersionNamesFuture GetBranch(const DataName& data_name,
                                const StructuredDataVersions::VersionName& branch_tip,
                                const std::chrono::steady_clock::duration& timeout =
                                    std::chrono::seconds(120));
 
+  // Returns at most 'limit' versions of the branch, starting at 'page_start' (the branch tip for
+  // the first page).  If the branch continues, the result's 'next_page_start' is set to the
+  // version from which to request the next page.
+  template <typename DataName>
+  BranchPageFuture GetBranch(const DataName& data_name,
+                             const StructuredDataVersions::VersionName& page_start, uint32_t limit,
+                             const std::chrono::steady_clock::duration& timeout =
+                                 std::chrono::seconds(120));
+
   // This should be the function used in the GroupToSingle (and maybe also SingleToSingle) functors
   // passed to 'routing.Join'.
   template <typename T>
@@ -113,8 +134,9 @@ DataGetter::VersionNamesFuture DataGetter::GetVersions(
     const DataName& data_name, const std::chrono::steady_clock::duration& timeout) {
   typedef DataGetterService::GetVersionsResponse::Contents ResponseContents;
   auto promise(std::make_shared<VersionNamesPromise>());
-  auto response_functor([promise](const StructuredDataNameAndContentOrReturnCode&
-                                  result) { HandleGetVersionsOrBranchResult(result, promise); });
+  auto response_functor([promise](StructuredDataNameAndContentOrReturnCode result) {
+                           HandleGetVersionsOrBranchResult(std::move(result), promise);
+                        });
   auto op_data(std::make_shared<nfs::OpData<ResponseContents>>(1, response_functor));
   auto task_id(get_versions_timer_.NewTaskId());
   get_versions_timer_.AddTask(
@@ -127,14 +149,35 @@ DataGetter::VersionNamesFuture DataGetter::GetVersions(
   return promise->get_future();
 }
 
+template <typename DataName>
+DataGetter::VersionNamesFuture DataGetter::GetVersionsSince(
+    const DataName& data_name, const StructuredDataVersions::VersionName& last_known_version,
+    const std::chrono::steady_clock::duration& timeout) {
+  typedef DataGetterService::GetVersionsResponse::Contents ResponseContents;
+  auto promise(std::make_shared<VersionNamesPromise>());
+  auto response_functor([promise](StructuredDataNameAndContentOrReturnCode result) {
+                           HandleGetVersionsOrBranchResult(std::move(result), promise);
+                        });
+  auto op_data(std::make_shared<nfs::OpData<ResponseContents>>(1, response_functor));
+  auto task_id(get_versions_timer_.NewTaskId());
+  get_versions_timer_.AddTask(
+      timeout, [op_data](ResponseContents get_versions_response) {
+                 op_data->HandleResponseContents(std::move(get_versions_response));
+               },
+      routing::Parameters::group_size * 2, task_id);
+  dispatcher_.SendGetVersionsSinceRequest(task_id, data_name, last_known_version);
+  return promise->get_future();
+}
+
 template <typename DataName>
 DataGetter::VersionNamesFuture DataGetter::GetBranch(
     const DataName& data_name, const StructuredDataVersions::VersionName& branch_tip,
     const std::chrono::steady_clock::duration& timeout) {
   typedef DataGetterService::GetBranchResponse::Contents ResponseContents;
   auto promise(std::make_shared<VersionNamesPromise>());
-  auto response_functor([promise](const StructuredDataNameAndContentOrReturnCode &
-                                  result) { HandleGetVersionsOrBranchResult(result, promise); });
+  auto response_functor([promise](StructuredDataNameAndContentOrReturnCode result) {
+                           HandleGetVersionsOrBranchResult(std::move(result), promise);
+                        });
   auto op_data(std::make_shared<nfs::OpData<ResponseContents>>(1, response_functor));
   auto task_id(get_branch_timer_.AddTask(timeout, [op_data](ResponseContents get_branch_response) {
                                                     op_data->HandleResponseContents(
@@ -142,7 +185,30 @@ DataGetter::VersionNamesFuture DataGetter::GetBranch(
                                                   },
                                          // TODO(Fraser#5#): 2013-08-18 - Confirm expected count
                                          routing::Parameters::group_size * 2));
-  dispatcher_.SendGetBranchRequest(task_id, data_name, branch_tip);
+  dispatcher_.SendGetBranchRequest(task_id, data_name, branch_tip, 0);
+  return promise->get_future();
+}
+
+template <typename DataName>
+DataGetter::BranchPageFuture DataGetter::GetBranch(
+    const DataName& data_name, const StructuredDataVersions::VersionName& page_start,
+    uint32_t limit, const std::chrono::steady_clock::duration& timeout) {
+  if (limit == 0 || limit == std::numeric_limits<uint32_t>::max())
+    BOOST_THROW_EXCEPTION(MakeError(CommonErrors::invalid_parameter));
+  typedef DataGetterService::GetBranchResponse::Contents ResponseContents;
+  auto promise(std::make_shared<boost::promise<BranchPage>>());
+  auto response_functor([promise, limit](StructuredDataNameAndContentOrReturnCode result) {
+                          HandleGetBranchPageResult(std::move(result), limit, promise);
+                        });
+  auto op_data(std::make_shared<nfs::OpData<ResponseContents>>(1, response_functor));
+  auto task_id(get_branch_timer_.NewTaskId());
+  get_branch_timer_.AddTask(timeout,
+      [op_data](ResponseContents get_branch_response) {
+          op_data->HandleResponseContents(std::move(get_branch_response));
+      },
+      routing::Parameters::group_size * 2, task_id);
+  // One more version than the page holds is requested, to find the start of the next page.
+  dispatcher_.SendGetBranchRequest(task_id, data_name, page_start, limit + 1);
   return promise->get_future();
 }
 
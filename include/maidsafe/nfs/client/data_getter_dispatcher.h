@@ -19,6 +19,7 @@
 #ifndef MAIDSAFE_NFS_CLIENT_DATA_GETTER_DISPATCHER_H_
 #define MAIDSAFE_NFS_CLIENT_DATA_GETTER_DISPATCHER_H_
 
+#include <cstdint>
 #include <string>
 
 #include "maidsafe/common/data_types/structured_data_versions.h"
@@ -45,9 +46,14 @@ class DataGetterDispatcher {
   template <typename DataName>
   void SendGetVersionsRequest(routing::TaskId task_id, const DataName& data_name);
 
+  template <typename DataName>
+  void SendGetVersionsSinceRequest(routing::TaskId task_id, const DataName& data_name,
+                                   const StructuredDataVersions::VersionName& last_known_version);
+
+  // A 'limit' of 0 requests the whole branch.
   template <typename DataName>
   void SendGetBranchRequest(routing::TaskId task_id, const DataName& data_name,
-                            const StructuredDataVersions::VersionName& branch_tip);
+                            const StructuredDataVersions::VersionName& branch_tip, uint32_t limit);
 
  private:
   DataGetterDispatcher();
@@ -98,17 +104,29 @@ void DataGetterDispatcher::SendGetVersionsRequest(routing::TaskId task_id,
                 << " routing message sent";
 }
 
+template <typename DataName>
+void DataGetterDispatcher::SendGetVersionsSinceRequest(
+    routing::TaskId task_id, const DataName& data_name,
+    const StructuredDataVersions::VersionName& last_known_version) {
+  typedef nfs::GetVersionsSinceRequestFromDataGetterToVersionHandler NfsMessage;
+  CheckSourcePersonaType<NfsMessage>();
+  typedef routing::Message<NfsMessage::Sender, NfsMessage::Receiver> RoutingMessage;
+
+  NfsMessage::Contents contents(data_name, last_known_version);
+  NfsMessage nfs_message(nfs::MessageId(task_id), contents);
+  NfsMessage::Receiver receiver(routing::GroupId(NodeId(data_name->string())));
+  routing_.Send(RoutingMessage(nfs_message.Serialise(), kThisNodeAsSender_, receiver));
+}
+
 template <typename DataName>
 void DataGetterDispatcher::SendGetBranchRequest(
     routing::TaskId task_id, const DataName& data_name,
-    const StructuredDataVersions::VersionName& branch_tip) {
+    const StructuredDataVersions::VersionName& branch_tip, uint32_t limit) {
   typedef nfs::GetBranchRequestFromDataGetterToVersionHandler NfsMessage;
   CheckSourcePersonaType<NfsMessage>();
   typedef routing::Message<NfsMessage::Sender, NfsMessage::Receiver> RoutingMessage;
 
-  NfsMessage::Contents contents;
-  contents.data_name = DataName(data_name);
-  contents.version_name = branch_tip;
+  NfsMessage::Contents contents(data_name, branch_tip, limit);
   NfsMessage nfs_message(nfs::MessageId(task_id), contents);
   NfsMessage::Receiver receiver(routing::GroupId(NodeId(data_name->string())));
   routing_.Send(RoutingMessage(nfs_message.Serialise(), kThisNodeAsSender_, receiver));
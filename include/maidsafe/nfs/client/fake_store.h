@@ -19,9 +19,11 @@
 #ifndef MAIDSAFE_NFS_CLIENT_FAKE_STORE_H_
 #define MAIDSAFE_NFS_CLIENT_FAKE_STORE_H_
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <utility>
 #include <vector>
 
@@ -79,6 +81,12 @@ class FakeStore {
                                  const std::chrono::steady_clock::duration& timeout =
                                      std::chrono::seconds(10));
 
+  template <typename DataName>
+  VersionNamesFuture GetVersionsSince(const DataName& data_name,
+                                      const StructuredDataVersions::VersionName& last_known_version,
+                                      const std::chrono::steady_clock::duration& timeout =
+                                          std::chrono::seconds(10));
+
   template <typename DataName>
   VersionNamesFuture GetBranch(const DataName& data_name,
                                const StructuredDataVersions::VersionName& branch_tip,
@@ -230,6 +238,51 @@ FakeStore::VersionNamesFuture FakeStore::GetVersions(
   return promise->get_future();
 }
 
+template <typename DataName>
+FakeStore::VersionNamesFuture FakeStore::GetVersionsSince(
+    const DataName& data_name, const StructuredDataVersions::VersionName& last_known_version,
+    const std::chrono::steady_clock::duration& /*timeout*/) {
+  LOG(kVerbose) << "Getting versions since " << last_known_version.index << "-"
+                << HexSubstr(last_known_version.id.value) << ": " << HexSubstr(data_name.value);
+  auto promise(std::make_shared<VersionNamesPromise>());
+  auto async_future(boost::async([=] {
+    try {
+      KeyType key(data_name);
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      auto versions(this->ReadVersions(key));
+      if (!versions)
+        BOOST_THROW_EXCEPTION(MakeError(CommonErrors::no_such_element));
+      // Collect the versions above 'last_known_version' on every branch descending from it.  Each
+      // version has a single parent, so once a version already collected is reached, the rest of
+      // the branch down to 'last_known_version' has been collected too.
+      std::vector<StructuredDataVersions::VersionName> newer_versions;
+      std::set<StructuredDataVersions::VersionName> seen;
+      bool found(false);
+      for (const auto& tip : versions->Get()) {
+        auto branch(versions->GetBranch(tip));
+        auto last_known_itr(std::find(std::begin(branch), std::end(branch), last_known_version));
+        if (last_known_itr == std::end(branch))
+          continue;
+        found = true;
+        for (auto itr(std::begin(branch)); itr != last_known_itr; ++itr) {
+          if (!seen.insert(*itr).second)
+            break;
+          newer_versions.push_back(*itr);
+        }
+      }
+      if (!found)
+        BOOST_THROW_EXCEPTION(MakeError(CommonErrors::no_such_element));
+      promise->set_value(newer_versions);
+    }
+    catch (const std::exception& e) {
+      LOG(kError) << "Failed getting versions since: " << boost::diagnostic_information(e);
+      promise->set_exception(boost::current_exception());
+    }
+  }));
+  static_cast<void>(async_future);
+  return promise->get_future();
+}
+
 template <typename DataName>
 FakeStore::VersionNamesFuture FakeStore::GetBranch(
     const DataName& data_name, const StructuredDataVersions::VersionName& branch_tip,
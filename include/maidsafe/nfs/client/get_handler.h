@@ -19,22 +19,36 @@
 #ifndef MAIDSAFE_NFS_CLIENT_GET_HANDLER_H_
 #define MAIDSAFE_NFS_CLIENT_GET_HANDLER_H_
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <tuple>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
+#include "boost/asio/steady_timer.hpp"
 #include "boost/thread/future.hpp"
 
+#include "maidsafe/common/asio_service.h"
+
 #include "maidsafe/common/data_types/data_name_variant.h"
 
 #include "maidsafe/routing/routing_api.h"
 #include "maidsafe/routing/timer.h"
 
+#include "maidsafe/nfs/lazy_contents.h"
 #include "maidsafe/nfs/service.h"
 #include "maidsafe/nfs/client/maid_node_dispatcher.h"
 #include "maidsafe/nfs/client/maid_node_service.h"
+#include "maidsafe/nfs/client/chunk_cache.h"
 #include "maidsafe/nfs/client/client_utils.h"
+#include "maidsafe/nfs/client/latency_estimator.h"
 
 namespace maidsafe {
 
@@ -58,24 +72,42 @@ class GetHandlerVisitor : public boost::static_visitor<> {
   const routing::TaskId kTaskId_;
 };
 
-class ValidateDataVisitor : public boost::static_visitor<bool> {
- public:
-  explicit ValidateDataVisitor(const nfs_vault::Content& content) : content_(content) {}
-
-  template<typename DataNameType>
-  result_type operator()(const DataNameType& data_name) {
-    return (typename DataNameType::data_type(data_name,
-                     typename DataNameType::data_type::serialised_type(
-                         NonEmptyString(content_.data)))).name() == data_name;
-  }
-
- private:
-  nfs_vault::Content content_;
-};
+// When hedging is enabled, a duplicate request is sent for a Get which has had no valid response
+// within this percentile of recently observed Get latencies.  No Gets are hedged until
+// kMinGetHedgeSamples latencies have been observed.
+const double kGetHedgePercentile(0.95);
+const size_t kMinGetHedgeSamples(20);
 
 template <typename DistaptcherType>
 class GetHandler {
-  typedef std::tuple<size_t, routing::TaskId, DataNameVariant> GetInfo;
+  typedef std::function<bool(const nfs_vault::Content&)> Validator;
+  // Number of failures received for the request, original task id, name of the chunk, time at
+  // which the request was sent and validator for the content of responses.
+  typedef std::tuple<size_t, routing::TaskId, DataNameVariant,
+                     std::chrono::steady_clock::time_point, Validator> GetInfo;
+  typedef std::function<void(const DataNameAndContentOrReturnCode&)> ResultFunctor;
+  // A caller which joined a Get in flight.  If that Get succeeds or fails, 'handle_result' is
+  // invoked with its result.  If it times out, 'retry' (see MakeRetry) is invoked with the
+  // timed-out result instead.
+  struct Waiter {
+    ResultFunctor handle_result;
+    ResultFunctor retry;
+  };
+  // The validated data of a Get in flight (a ValidatedData<Data> of the appropriate type), and the
+  // callers which joined it.
+  struct InFlightGet {
+    std::shared_ptr<void> validated_data;
+    std::vector<Waiter> waiters;
+  };
+  // Shared with the handlers this posts to asio (hedge timers' handlers and retries of timed-out
+  // Gets), which can run after the GetHandler has been destroyed (e.g. if already queued when the
+  // hedge timers are cancelled).  They only use the GetHandler while holding 'mutex' and if
+  // 'stopped' is false, and the destructor sets 'stopped'.
+  struct AsyncGuard {
+    AsyncGuard() : mutex(), stopped(false) {}
+    std::mutex mutex;
+    bool stopped;
+  };
   enum class Operation : int {
     kNoOperation = 0,
     kAddResponse = 1,
@@ -84,42 +116,219 @@ class GetHandler {
   };
 
  public:
-  GetHandler(routing::Timer<DataNameAndContentOrReturnCode>& get_timer,
+  GetHandler(AsioService& asio_service,
+             routing::Timer<DataNameAndContentOrReturnCode>& get_timer,
              DistaptcherType& dispatcher)
-      : get_timer_(get_timer), dispatcher_(dispatcher), get_info_(), mutex_() {}
-
+      : asio_service_(asio_service), get_timer_(get_timer), dispatcher_(dispatcher), get_info_(),
+        current_task_ids_(), in_flight_gets_(), chunk_cache_(), hedging_(false),
+        hedge_timers_(), async_guard_(std::make_shared<AsyncGuard>()), get_latency_(),
+        mutex_() {}
+
+  ~GetHandler();
+
+  // Enables or disables hedging of Gets (see kGetHedgePercentile).  Whichever of the original and
+  // hedged requests first returns valid content completes the Get; responses to the other are
+  // dropped.
+  void SetHedging(bool enabled);
+
+  // Gets of ImmutableData are served from 'chunk_cache' where possible, and chunks fetched from the
+  // network are added to it.  Pass nullptr to stop using a cache.
+  void SetChunkCache(std::shared_ptr<ChunkCache> chunk_cache);
+
+  // If a Get for 'data_name' is already in flight, no new request is sent; 'promise' is instead
+  // fulfilled with the result of the existing request.  Requests time out as adapted to recent Get
+  // latencies (see AdaptiveTimeout); if one times out before 'timeout' has elapsed, the Get is
+  // re-issued for the remainder of 'timeout'.
   template <typename DataName>
   void Get(const DataName& data_name,
            std::shared_ptr<boost::promise<typename DataName::data_type>> promise,
            const std::chrono::steady_clock::duration& timeout);
 
+  // The contents of 'lazy_response' are only parsed if 'task_id' refers to a pending Get, so
+  // duplicate and late responses are dropped without being decoded.
+  void AddResponse(routing::TaskId task_id,
+                   const nfs::LazyContents<DataNameAndContentOrReturnCode>& lazy_response);
+
   void AddResponse(routing::TaskId task_id, const DataNameAndContentOrReturnCode& response);
 
  private:
-  bool ValidateData(const nfs_vault::Content& content, const DataNameVariant& data_name);
+  // Sets up the timer task for a single name, with 'callback' invoked with the result.  The data in
+  // the first valid response is kept in 'validated_data'.
+  template <typename DataName>
+  routing::TaskId AddGetTask(
+      const DataName& data_name, std::function<void(DataNameAndContentOrReturnCode)> callback,
+      std::shared_ptr<ValidatedData<typename DataName::data_type>> validated_data,
+      const std::chrono::steady_clock::duration& timeout);
+
+  // Sends a duplicate request for the Get with 'original_task_id' if it is still waiting for its
+  // first request.
+  void Hedge(routing::TaskId original_task_id);
+
+  // Returns a functor which, given the timed-out result of a Get for 'data_name', re-issues the Get
+  // with whatever remains until 'deadline', or passes the result to 'handle_result' if none does.
+  template <typename DataName>
+  ResultFunctor MakeRetry(const DataName& data_name,
+                          std::shared_ptr<boost::promise<typename DataName::data_type>> promise,
+                          std::chrono::steady_clock::time_point deadline,
+                          ResultFunctor handle_result);
+
+  // Posted, since this is called from within the Get timer's handling of the result.
+  void PostRetry(const ResultFunctor& retry, const DataNameAndContentOrReturnCode& result);
+
+  AsioService& asio_service_;
   routing::Timer<DataNameAndContentOrReturnCode>& get_timer_;
   DistaptcherType& dispatcher_;
-  std::map<routing::TaskId, GetInfo> get_info_;
+  // Keyed by the id of each request outstanding for a Get, which differs from the original (timer)
+  // task id once the Get has been retried or hedged.
+  std::unordered_map<routing::TaskId, GetInfo> get_info_;
+  // Maps each original task id to the keys of its entries in get_info_.
+  std::unordered_map<routing::TaskId, std::vector<routing::TaskId>> current_task_ids_;
+  // Keyed on type as well as raw name, since nfs_vault::DataName's operator< ignores the type.
+  std::map<TypedDataName, InFlightGet> in_flight_gets_;
+  std::shared_ptr<ChunkCache> chunk_cache_;
+  // Atomic so that it can be read without holding 'mutex_'.
+  std::atomic<bool> hedging_;
+  // Keyed by original task id.
+  std::unordered_map<routing::TaskId, std::shared_ptr<boost::asio::steady_timer>> hedge_timers_;
+  std::shared_ptr<AsyncGuard> async_guard_;
+  LatencyEstimator get_latency_;
   std::mutex mutex_;
 };
 
+template <typename DistaptcherType>
+GetHandler<DistaptcherType>::~GetHandler() {
+  {
+    std::lock_guard<std::mutex> guard_lock(async_guard_->mutex);
+    async_guard_->stopped = true;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& hedge_timer : hedge_timers_)
+    hedge_timer.second->cancel();
+}
+
+template <typename DistaptcherType>
+void GetHandler<DistaptcherType>::SetHedging(bool enabled) {
+  hedging_ = enabled;
+}
+
+template <typename DistaptcherType>
+void GetHandler<DistaptcherType>::SetChunkCache(std::shared_ptr<ChunkCache> chunk_cache) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  chunk_cache_ = std::move(chunk_cache);
+}
+
 template <typename DistaptcherType>
 template <typename DataName>
 void GetHandler<DistaptcherType>::Get(
     const DataName& data_name,
     std::shared_ptr<boost::promise<typename DataName::data_type>> promise,
     const std::chrono::steady_clock::duration& timeout) {
+  std::shared_ptr<ChunkCache> chunk_cache;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    chunk_cache = chunk_cache_;
+  }
+  if (chunk_cache && GetFromChunkCache(*chunk_cache, data_name, *promise))
+    return;
+
+  auto deadline(std::chrono::steady_clock::now() + timeout);
+
+  typedef ValidatedData<typename DataName::data_type> Validated;
+  auto name(GetTypedDataName(nfs_vault::DataName(data_name)));
+  auto validated_data(std::make_shared<Validated>());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto in_flight(in_flight_gets_.find(name));
+    if (in_flight != std::end(in_flight_gets_)) {
+      LOG(kVerbose) << "GetHandler joining in-flight Get for " << HexSubstr(data_name.value);
+      // The key includes the data type, so the in-flight Get's validated data is of this type.
+      // Only the leading caller adds the chunk to the cache.
+      HandleGetResult<typename DataName::data_type> handle_result(
+          promise, nullptr,
+          std::static_pointer_cast<Validated>(in_flight->second.validated_data));
+      Waiter waiter = { handle_result, MakeRetry(data_name, promise, deadline, handle_result) };
+      in_flight->second.waiters.push_back(std::move(waiter));
+      return;
+    }
+    InFlightGet in_flight_get = { validated_data, std::vector<Waiter>() };
+    in_flight_gets_.insert(std::make_pair(name, std::move(in_flight_get)));
+  }
+  // The leading caller takes the validated data, so it must be handled after any joined callers,
+  // which each take a copy.
+  HandleGetResult<typename DataName::data_type> handle_result(promise, chunk_cache,
+                                                              validated_data, true);
+  auto retry(MakeRetry(data_name, promise, deadline, handle_result));
+  auto task_id(AddGetTask(data_name,
+                          [handle_result, retry, name, this](
+                              DataNameAndContentOrReturnCode result) {
+                            std::vector<Waiter> waiters;
+                            {
+                              std::lock_guard<std::mutex> lock(mutex_);
+                              auto in_flight(in_flight_gets_.find(name));
+                              if (in_flight != std::end(in_flight_gets_)) {
+                                waiters.swap(in_flight->second.waiters);
+                                in_flight_gets_.erase(in_flight);
+                              }
+                            }
+                            bool timed_out(!result.content && result.return_code &&
+                                           IsTimeout(result.return_code->value.code()));
+                            for (const auto& waiter : waiters) {
+                              if (timed_out)
+                                PostRetry(waiter.retry, result);
+                              else
+                                waiter.handle_result(result);
+                            }
+                            if (timed_out)
+                              PostRetry(retry, result);
+                            else
+                              handle_result(result);
+                          }, validated_data, timeout));
+  dispatcher_.SendGetRequest(task_id, data_name);
+}
+
+template <typename DistaptcherType>
+template <typename DataName>
+routing::TaskId GetHandler<DistaptcherType>::AddGetTask(
+    const DataName& data_name, std::function<void(DataNameAndContentOrReturnCode)> callback,
+    std::shared_ptr<ValidatedData<typename DataName::data_type>> validated_data,
+    const std::chrono::steady_clock::duration& timeout) {
   auto task_id(get_timer_.NewTaskId());
-  HandleGetResult<typename DataName::data_type> response_functor(promise);
-  auto op_data(
-           std::make_shared<nfs::OpData<DataNameAndContentOrReturnCode>>(1, response_functor));
+  auto op_data(std::make_shared<nfs::OpData<DataNameAndContentOrReturnCode>>(
+      1, std::move(callback)));
+  auto adaptive_timeout(AdaptiveTimeout(get_latency_, timeout));
+  // Calculated before taking the lock, since it copies and partially sorts the recent samples.
+  boost::optional<LatencyEstimator::Duration> hedge_delay;
+  if (hedging_)
+    hedge_delay = get_latency_.Percentile(kGetHedgePercentile, kMinGetHedgeSamples);
+  std::shared_ptr<boost::asio::steady_timer> hedge_timer;
   {
     std::lock_guard<std::mutex> lock(mutex_);
     get_info_.insert(std::make_pair(task_id, std::make_tuple(0, task_id,
                                     GetDataNameVariant(DataName::data_type::Tag::kValue,
-                                                       data_name.value))));
+                                                       data_name.value),
+                                    std::chrono::steady_clock::now(),
+                                    [data_name, validated_data](const nfs_vault::Content& content) {
+                                      return validated_data->Validate(data_name, content);
+                                    })));
+    current_task_ids_.insert(std::make_pair(task_id, std::vector<routing::TaskId>(1, task_id)));
+    if (hedge_delay && *hedge_delay < adaptive_timeout) {
+      hedge_timer = std::make_shared<boost::asio::steady_timer>(asio_service_.service(),
+                                                                *hedge_delay);
+      hedge_timers_.insert(std::make_pair(task_id, hedge_timer));
+    }
+  }
+  if (hedge_timer) {
+    auto async_guard(async_guard_);
+    hedge_timer->async_wait([task_id, async_guard, this](
+        const boost::system::error_code& error_code) {
+      if (error_code == boost::asio::error::operation_aborted)
+        return;
+      std::lock_guard<std::mutex> guard_lock(async_guard->mutex);
+      if (!async_guard->stopped)
+        Hedge(task_id);
+    });
   }
-  get_timer_.AddTask(timeout,
+  get_timer_.AddTask(adaptive_timeout,
                      [op_data, data_name, task_id, this](
                          DataNameAndContentOrReturnCode get_response) {
                         LOG(kVerbose) << "GetHandler Get HandleResponseContents for "
@@ -127,47 +336,70 @@ void GetHandler<DistaptcherType>::Get(
                         op_data->HandleResponseContents(std::move(get_response));
                         {
                           std::lock_guard<std::mutex> lock(mutex_);
-                          auto iter(std::find_if(std::begin(get_info_), std::end(get_info_),
-                                                 [task_id](const std::pair<routing::TaskId,
-                                                                           GetInfo>& info) {
-                                                   return std::get<1>(info.second) == task_id;
-                                                 }));
-                          if (iter != std::end(get_info_))
-                            get_info_.erase(iter);
+                          auto current(current_task_ids_.find(task_id));
+                          if (current != std::end(current_task_ids_)) {
+                            for (auto request_id : current->second)
+                              get_info_.erase(request_id);
+                            current_task_ids_.erase(current);
+                          }
+                          auto hedge_timer(hedge_timers_.find(task_id));
+                          if (hedge_timer != std::end(hedge_timers_)) {
+                            hedge_timer->second->cancel();
+                            hedge_timers_.erase(hedge_timer);
+                          }
                         }
                      }, 1, task_id);
-  dispatcher_.SendGetRequest(task_id, data_name);
+  return task_id;
 }
 
 template <typename DistaptcherType>
 void GetHandler<DistaptcherType>::AddResponse(routing::TaskId task_id,
                                               const DataNameAndContentOrReturnCode& response) {
+  AddResponse(task_id, nfs::LazyContents<DataNameAndContentOrReturnCode>(response));
+}
+
+template <typename DistaptcherType>
+void GetHandler<DistaptcherType>::AddResponse(
+    routing::TaskId task_id,
+    const nfs::LazyContents<DataNameAndContentOrReturnCode>& lazy_response) {
   LOG(kVerbose) << " GetHandler::AddResponse "  << task_id;
   Operation operation(Operation::kNoOperation);
   routing::TaskId new_task_id(0);
   GetInfo get_info;
-
   {
     std::lock_guard<std::mutex> lock(mutex_);
     auto found(get_info_.find(task_id));
-    if (found == std::end(get_info_))
+    if (found == std::end(get_info_) || std::get<1>(found->second) == 0)
       return;
+    get_info = found->second;
+  }
 
-    if (std::get<1>(get_info_[task_id]) == 0)
-      return;
+  // Parsing and validating the content (which hashes the whole chunk) is done without holding the
+  // lock, so that responses to different Gets can be handled concurrently.
+  const DataNameAndContentOrReturnCode& response(*lazy_response);
+  bool valid(response.content && std::get<4>(get_info)(*response.content));
 
-    get_info = get_info_[task_id];
-    std::get<0>(get_info_[task_id])++;
-    if (response.content && ValidateData(*response.content, std::get<2>(get_info_[task_id]))) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // The request may have completed, been retried or been cancelled in the meantime.
+    auto found(get_info_.find(task_id));
+    if (found == std::end(get_info_))
+      return;
+    ++std::get<0>(found->second);
+    if (valid) {
       operation = Operation::kAddResponse;
     } else if (response.return_code &&
                response.return_code->value.code() != make_error_code(CommonErrors::defaulted) &&
-               (std::get<0>(get_info_[task_id]) == routing::Parameters::group_size - 1)) {
+               (std::get<0>(found->second) == routing::Parameters::group_size - 1)) {
       new_task_id = get_timer_.NewTaskId();
+      get_info_.erase(found);
       get_info_.insert(std::make_pair(new_task_id,
-                                      std::make_tuple(0, std::get<1>(get_info_[task_id]),
-                                                      std::get<2>(get_info_[task_id]))));
-      get_info_.erase(task_id);
+                                      std::make_tuple(0, std::get<1>(get_info),
+                                                      std::get<2>(get_info),
+                                                      std::chrono::steady_clock::now(),
+                                                      std::get<4>(get_info))));
+      auto& request_ids(current_task_ids_[std::get<1>(get_info)]);
+      std::replace(std::begin(request_ids), std::end(request_ids), task_id, new_task_id);
       operation = Operation::kSendRequest;
     } else if (response.return_code &&
                response.return_code->value.code() == make_error_code(CommonErrors::defaulted) &&
@@ -178,24 +410,74 @@ void GetHandler<DistaptcherType>::AddResponse(routing::TaskId task_id,
   }
 
   LOG(kVerbose) << " GetHandler::AddResponse "  << task_id
-                << " original task id: " << std::get<1>(get_info_[task_id])
+                << " original task id: " << std::get<1>(get_info)
                 << " operation " << static_cast<int>(operation);
 
   if (operation == Operation::kAddResponse) {
-    get_timer_.AddResponse(std::get<1>(get_info), response);
+    get_latency_.AddSample(std::chrono::steady_clock::now() - std::get<3>(get_info));
+    get_timer_.AddResponse(std::get<1>(get_info), *lazy_response);
   } else if (operation == Operation::kSendRequest) {
     GetHandlerVisitor<DistaptcherType> get_handler_visitor(dispatcher_, new_task_id);
-    boost::apply_visitor(get_handler_visitor, std::get<2>(get_info_[new_task_id]));
+    boost::apply_visitor(get_handler_visitor, std::get<2>(get_info));
   } else if (operation == Operation::kCancelTask) {
+    get_latency_.AddTimeout();
     get_timer_.CancelTask(std::get<1>(get_info));
   }
 }
 
 template <typename DistaptcherType>
-bool GetHandler<DistaptcherType>::ValidateData(const nfs_vault::Content& content,
-                              const DataNameVariant& data_name) {
-  ValidateDataVisitor validate_data_visitor(content);
-  return boost::apply_visitor(validate_data_visitor, data_name);
+template <typename DataName>
+typename GetHandler<DistaptcherType>::ResultFunctor GetHandler<DistaptcherType>::MakeRetry(
+    const DataName& data_name,
+    std::shared_ptr<boost::promise<typename DataName::data_type>> promise,
+    std::chrono::steady_clock::time_point deadline, ResultFunctor handle_result) {
+  return [data_name, promise, deadline, handle_result, this](
+      const DataNameAndContentOrReturnCode& timed_out_result) {
+    auto remaining(deadline - std::chrono::steady_clock::now());
+    if (remaining <= std::chrono::steady_clock::duration::zero()) {
+      handle_result(timed_out_result);
+      return;
+    }
+    LOG(kVerbose) << "GetHandler re-issuing timed-out Get for " << HexSubstr(data_name.value);
+    Get(data_name, promise, remaining);
+  };
+}
+
+template <typename DistaptcherType>
+void GetHandler<DistaptcherType>::PostRetry(const ResultFunctor& retry,
+                                            const DataNameAndContentOrReturnCode& result) {
+  auto async_guard(async_guard_);
+  asio_service_.service().post([retry, result, async_guard] {
+    std::lock_guard<std::mutex> guard_lock(async_guard->mutex);
+    if (!async_guard->stopped)
+      retry(result);
+  });
+}
+
+template <typename DistaptcherType>
+void GetHandler<DistaptcherType>::Hedge(routing::TaskId original_task_id) {
+  routing::TaskId hedge_task_id(0);
+  GetInfo get_info;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    hedge_timers_.erase(original_task_id);
+    auto current(current_task_ids_.find(original_task_id));
+    if (current == std::end(current_task_ids_) || current->second.size() != 1)
+      return;
+    auto found(get_info_.find(current->second.front()));
+    if (found == std::end(get_info_))
+      return;
+    hedge_task_id = get_timer_.NewTaskId();
+    get_info = found->second;
+    std::get<0>(get_info) = 0;
+    std::get<3>(get_info) = std::chrono::steady_clock::now();
+    get_info_.insert(std::make_pair(hedge_task_id, get_info));
+    current->second.push_back(hedge_task_id);
+  }
+  LOG(kVerbose) << " GetHandler::Hedge original task id: " << original_task_id
+                << " hedged with " << hedge_task_id;
+  GetHandlerVisitor<DistaptcherType> get_handler_visitor(dispatcher_, hedge_task_id);
+  boost::apply_visitor(get_handler_visitor, std::get<2>(get_info));
 }
 
 }  // namespace nfs_client
@@ -0,0 +1,87 @@
+/*  Copyright 2013 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#ifndef MAIDSAFE_NFS_CLIENT_LATENCY_ESTIMATOR_H_
+#define MAIDSAFE_NFS_CLIENT_LATENCY_ESTIMATOR_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "boost/optional/optional.hpp"
+
+namespace maidsafe {
+
+namespace nfs_client {
+
+// Keeps the most recent kSampleCount latencies observed for one kind of operation, along with a
+// smoothed round-trip time (SRTT) and round-trip time variation (RTTVAR) as per RFC 6298, and the
+// number of timeouts since the last sample.  Thread-safe.
+class LatencyEstimator {
+ public:
+  typedef std::chrono::steady_clock::duration Duration;
+
+  static const size_t kSampleCount;
+  // AdaptiveTimeout doesn't adapt until this many samples have been recorded, and never goes
+  // below kMinAdaptiveTimeout.
+  static const size_t kMinAdaptiveTimeoutSamples;
+  static const Duration kMinAdaptiveTimeout;
+
+  LatencyEstimator();
+
+  // Also resets the count of timeouts.
+  void AddSample(Duration latency);
+
+  // Records that an operation timed out.  Each consecutive timeout doubles AdaptiveTimeout (as per
+  // RFC 6298, section 5.5) until the next sample is added.
+  void AddTimeout();
+  unsigned TimeoutCount() const;
+
+  // Returns the latency not exceeded by 'percentile' (in [0, 1]) of the recorded samples, or
+  // boost::none if fewer than 'minimum_samples' have been recorded.
+  boost::optional<Duration> Percentile(double percentile, size_t minimum_samples) const;
+
+  // Returns SRTT + 4 * RTTVAR, or boost::none if fewer than 'minimum_samples' have been recorded.
+  boost::optional<Duration> RetransmissionTimeout(size_t minimum_samples) const;
+
+ private:
+  LatencyEstimator(const LatencyEstimator&);
+  LatencyEstimator(LatencyEstimator&&);
+  LatencyEstimator& operator=(LatencyEstimator);
+
+  std::vector<Duration> samples_;
+  size_t next_sample_;
+  uint64_t sample_count_;
+  unsigned timeout_count_;
+  Duration smoothed_rtt_, rtt_variation_;
+  mutable std::mutex mutex_;
+};
+
+// Returns the retransmission timeout of 'estimator', not less than kMinAdaptiveTimeout and doubled
+// for each timeout since the last sample, as the timeout for a new operation.  'timeout' is
+// returned if it is smaller, or if there are too few samples to adapt.
+LatencyEstimator::Duration AdaptiveTimeout(const LatencyEstimator& estimator,
+                                           LatencyEstimator::Duration timeout);
+
+}  // namespace nfs_client
+
+}  // namespace maidsafe
+
+#endif  // MAIDSAFE_NFS_CLIENT_LATENCY_ESTIMATOR_H_
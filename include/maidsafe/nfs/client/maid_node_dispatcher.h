@@ -51,6 +51,8 @@ class MaidNodeDispatcher {
   template <typename Data>
   void SendPutRequest(routing::TaskId task_id, const Data& data);
 
+  void SendPutBatchRequest(routing::TaskId task_id, const nfs_vault::DataNamesAndContents& data);
+
   template <typename DataName>
   void SendDeleteRequest(const DataName& data_name);
 
@@ -62,9 +64,14 @@ class MaidNodeDispatcher {
   template <typename DataName>
   void SendGetVersionsRequest(routing::TaskId task_id, const DataName& data_name);
 
+  template <typename DataName>
+  void SendGetVersionsSinceRequest(routing::TaskId task_id, const DataName& data_name,
+                                   const StructuredDataVersions::VersionName& last_known_version);
+
+  // A 'limit' of 0 requests the whole branch.
   template <typename DataName>
   void SendGetBranchRequest(routing::TaskId task_id, const DataName& data_name,
-                            const StructuredDataVersions::VersionName& branch_tip);
+                            const StructuredDataVersions::VersionName& branch_tip, uint32_t limit);
 
   template <typename DataName>
   void SendPutVersionRequest(routing::TaskId task_id, const DataName& data_name,
@@ -154,15 +161,29 @@ void MaidNodeDispatcher::SendGetVersionsRequest(routing::TaskId task_id,
   RoutingSend(RoutingMessage(nfs_message.Serialise(), kThisNodeAsSender_, receiver));
 }
 
+template <typename DataName>
+void MaidNodeDispatcher::SendGetVersionsSinceRequest(
+    routing::TaskId task_id, const DataName& data_name,
+    const StructuredDataVersions::VersionName& last_known_version) {
+  typedef nfs::GetVersionsSinceRequestFromMaidNodeToVersionHandler NfsMessage;
+  CheckSourcePersonaType<NfsMessage>();
+  typedef routing::Message<NfsMessage::Sender, NfsMessage::Receiver> RoutingMessage;
+
+  NfsMessage::Contents contents(data_name, last_known_version);
+  NfsMessage nfs_message(nfs::MessageId(task_id), contents);
+  NfsMessage::Receiver receiver(routing::GroupId(NodeId(data_name->string())));
+  RoutingSend(RoutingMessage(nfs_message.Serialise(), kThisNodeAsSender_, receiver));
+}
+
 template <typename DataName>
 void MaidNodeDispatcher::SendGetBranchRequest(
     routing::TaskId task_id, const DataName& data_name,
-    const StructuredDataVersions::VersionName& branch_tip) {
+    const StructuredDataVersions::VersionName& branch_tip, uint32_t limit) {
   typedef nfs::GetBranchRequestFromMaidNodeToVersionHandler NfsMessage;
   CheckSourcePersonaType<NfsMessage>();
   typedef routing::Message<NfsMessage::Sender, NfsMessage::Receiver> RoutingMessage;
 
-  NfsMessage::Contents contents(data_name, branch_tip);
+  NfsMessage::Contents contents(data_name, branch_tip, limit);
   NfsMessage nfs_message(nfs::MessageId(task_id), contents);
   NfsMessage::Receiver receiver(routing::GroupId(NodeId(data_name->string())));
   RoutingSend(RoutingMessage(nfs_message.Serialise(), kThisNodeAsSender_, receiver));
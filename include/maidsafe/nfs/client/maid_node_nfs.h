@@ -19,12 +19,18 @@
 #ifndef MAIDSAFE_NFS_CLIENT_MAID_NODE_NFS_H_
 #define MAIDSAFE_NFS_CLIENT_MAID_NODE_NFS_H_
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
 
+#include "boost/exception_ptr.hpp"
+#include "boost/optional/optional.hpp"
 #include "boost/signals2/signal.hpp"
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -47,6 +53,7 @@
 #include "maidsafe/nfs/message_wrapper.h"
 #include "maidsafe/nfs/service.h"
 #include "maidsafe/nfs/utils.h"
+#include "maidsafe/nfs/client/chunk_cache.h"
 #include "maidsafe/nfs/client/client_utils.h"
 #include "maidsafe/nfs/client/maid_node_dispatcher.h"
 #include "maidsafe/nfs/client/maid_node_service.h"
@@ -61,6 +68,7 @@ namespace nfs_client {
 class MaidNodeNfs : public std::enable_shared_from_this<MaidNodeNfs>  {
  public:
   typedef boost::future<std::vector<StructuredDataVersions::VersionName>> VersionNamesFuture;
+  typedef boost::future<BranchPage> BranchPageFuture;
   typedef boost::future<std::unique_ptr<StructuredDataVersions::VersionName>> PutVersionFuture;
   typedef boost::signals2::signal<void(int32_t)> OnNetworkHealthChange;
 
@@ -73,7 +81,18 @@ class MaidNodeNfs : public std::enable_shared_from_this<MaidNodeNfs>  {
 
   OnNetworkHealthChange& network_health_change_signal();
 
+  // Once set, Gets of ImmutableData are served from 'chunk_cache' where possible, and chunks
+  // fetched from the network are added to it.  Pass nullptr to stop using a cache.
+  void SetChunkCache(std::shared_ptr<ChunkCache> chunk_cache);
+
+  // When enabled, a Get which is slow compared to recent Gets is hedged by sending a duplicate
+  // request, and completed by whichever returns valid content first.  Disabled by default.
+  void SetGetHedging(bool enabled);
+
   //========================== Data accessors and mutators =========================================
+  // Each request of a Get times out as adapted to the latencies of recent Gets (see
+  // AdaptiveTimeout), and is re-sent on timing out until 'timeout' has elapsed.  Other operations
+  // have no retry path, so they wait for the whole of 'timeout'.
   template <typename DataName>
   boost::future<typename DataName::data_type> Get(
       const DataName& data_name,
@@ -83,6 +102,35 @@ class MaidNodeNfs : public std::enable_shared_from_this<MaidNodeNfs>  {
   boost::future<void> Put(const Data& data, const std::chrono::steady_clock::duration& timeout =
                                                 std::chrono::seconds(360));
 
+  // Stores all of 'data' using PutBatchRequests, each carrying as many chunks as fit in
+  // kMaxPutBatchContentSize.  Returns one future per element of 'data' (in the same order), each
+  // behaving as the one returned by Put for that element.
+  template <typename Data>
+  std::vector<boost::future<void>> PutMany(
+      const std::vector<Data>& data,
+      const std::chrono::steady_clock::duration& timeout = std::chrono::seconds(360));
+
+  // Stores every chunk returned by 'next_chunk', which returns boost::none once there are no more.
+  // At most 'max_in_flight' Puts are outstanding at any time, and 'next_chunk' isn't called again
+  // until one of them completes, so only that many chunks are held at once.  If set, 'on_result'
+  // is called (from an asio thread) as each Put completes, with the chunk's name and the outcome,
+  // which is CommonErrors::success if the Put succeeded.  The returned future is ready once every
+  // Put has completed, and holds the first failure if there was one.
+  template <typename Data>
+  boost::future<void> PutPipelined(
+      std::function<boost::optional<Data>()> next_chunk, size_t max_in_flight,
+      std::function<void(const typename Data::Name&, const maidsafe_error&)> on_result = nullptr,
+      const std::chrono::steady_clock::duration& timeout = std::chrono::seconds(360));
+
+  // As above, for the chunks in ['first', 'last'), which must remain valid until the returned
+  // future is ready.
+  template <typename InputIterator>
+  boost::future<void> PutPipelined(
+      InputIterator first, InputIterator last, size_t max_in_flight,
+      std::function<void(const typename std::iterator_traits<InputIterator>::value_type::Name&,
+                         const maidsafe_error&)> on_result = nullptr,
+      const std::chrono::steady_clock::duration& timeout = std::chrono::seconds(360));
+
   template <typename DataName>
   void Delete(const DataName& data_name);
 
@@ -107,12 +155,30 @@ class MaidNodeNfs : public std::enable_shared_from_this<MaidNodeNfs>  {
                                  const std::chrono::steady_clock::duration& timeout =
                                      std::chrono::seconds(120));
 
+  // As GetVersions, but only the versions added to the tree after 'last_known_version' are
+  // returned.  An empty result means that there have been no changes.  Fails if
+  // 'last_known_version' is no longer in the tree, in which case GetVersions should be used.
+  template <typename DataName>
+  VersionNamesFuture GetVersionsSince(const DataName& data_name,
+                                      const StructuredDataVersions::VersionName& last_known_version,
+                                      const std::chrono::steady_clock::duration& timeout =
+                                          std::chrono::seconds(120));
+
   template <typename DataName>
   VersionNamesFuture GetBranch(const DataName& data_name,
                                const StructuredDataVersions::VersionName& branch_tip,
                                const std::chrono::steady_clock::duration& timeout =
                                    std::chrono::seconds(120));
 
+  // Returns at most 'limit' versions of the branch, starting at 'page_start' (the branch tip for
+  // the first page).  If the branch continues, the result's 'next_page_start' is set to the
+  // version from which to request the next page.
+  template <typename DataName>
+  BranchPageFuture GetBranch(const DataName& data_name,
+                             const StructuredDataVersions::VersionName& page_start, uint32_t limit,
+                             const std::chrono::steady_clock::duration& timeout =
+                                 std::chrono::seconds(120));
+
   template <typename DataName>
   PutVersionFuture PutVersion(const DataName& data_name,
                               const StructuredDataVersions::VersionName& old_version_name,
@@ -136,6 +202,30 @@ class MaidNodeNfs : public std::enable_shared_from_this<MaidNodeNfs>  {
   typedef std::function<void(const StructuredDataNameAndContentOrReturnCode&)> GetVersionsFunctor;
   typedef std::function<void(const StructuredDataNameAndContentOrReturnCode&)> GetBranchFunctor;
   typedef boost::promise<std::vector<StructuredDataVersions::VersionName>> VersionNamesPromise;
+  typedef std::vector<std::shared_ptr<boost::promise<void>>> PutPromises;
+
+  // State shared by the Puts of one call to PutPipelined.
+  template <typename Data>
+  struct PipelinedPut {
+    typedef std::function<boost::optional<Data>()> ChunkFunctor;
+    typedef std::function<void(const typename Data::Name&, const maidsafe_error&)> ResultFunctor;
+    PipelinedPut(ChunkFunctor next_chunk_in, size_t max_in_flight_in, ResultFunctor on_result_in,
+                 const std::chrono::steady_clock::duration& timeout_in)
+        : next_chunk(std::move(next_chunk_in)), max_in_flight(max_in_flight_in),
+          on_result(std::move(on_result_in)), timeout(timeout_in), mutex(), in_flight(0),
+          exhausted(false), completed(false), first_failure(), promise() {}
+    ChunkFunctor next_chunk;
+    const size_t max_in_flight;
+    ResultFunctor on_result;
+    const std::chrono::steady_clock::duration timeout;
+    std::mutex mutex;
+    size_t in_flight;
+    bool exhausted, completed;
+    boost::exception_ptr first_failure;
+    boost::promise<void> promise;
+  };
+
+  static const size_t kMaxPutBatchContentSize;
 
   explicit MaidNodeNfs(const passport::Maid& maid);
 
@@ -158,6 +248,20 @@ class MaidNodeNfs : public std::enable_shared_from_this<MaidNodeNfs>  {
 
   void CreateAccount(const passport::PublicMaid& public_maid,
                      const passport::PublicAnmaid& public_anmaid);
+
+  // Sends a PutRequest for 'data', with 'callback' invoked with the group's result.
+  template <typename Data>
+  void SendPut(const Data& data, std::function<void(const ReturnCode&)> callback,
+               const std::chrono::steady_clock::duration& timeout);
+
+  // Issues Puts for 'state' until it has its maximum in flight or runs out of chunks, and fulfils
+  // its promise once it has run out of chunks and none are in flight.
+  template <typename Data>
+  void PumpPipelinedPut(std::shared_ptr<PipelinedPut<Data>> state);
+
+  // 'promises' must hold one entry per element of 'batch'.
+  void PutBatch(std::vector<nfs_vault::DataNameAndContent> batch, PutPromises promises,
+                const std::chrono::steady_clock::duration& timeout);
   void InitRouting(std::vector<passport::PublicPmid> = std::vector<passport::PublicPmid>());
 
   routing::Functors InitialiseRoutingCallbacks();
@@ -201,29 +305,159 @@ boost::future<typename DataName::data_type> MaidNodeNfs::Get(
 template <typename Data>
 boost::future<void> MaidNodeNfs::Put(const Data& data,
                                      const std::chrono::steady_clock::duration& timeout) {
+  auto promise(std::make_shared<boost::promise<void>>());
+  SendPut(data, [promise](const nfs_client::ReturnCode& result) {
+                  HandlePutResponseResult(result, promise);
+                }, timeout);
+  return promise->get_future();
+}
+
+template <typename Data>
+void MaidNodeNfs::SendPut(const Data& data, std::function<void(const ReturnCode&)> callback,
+                          const std::chrono::steady_clock::duration& timeout) {
   LOG(kVerbose) << "MaidNodeNfs put " << HexSubstr(data.name().value.string())
                 << " of size " << data.Serialise().data.string().size();
   typedef MaidNodeService::PutResponse::Contents ResponseContents;
-  auto promise(std::make_shared<boost::promise<void>>());
-  NodeId node_id;
-
-  auto response_functor([promise](const nfs_client::ReturnCode& result) {
-                           HandlePutResponseResult(result, promise);
-                        });
   auto op_data(std::make_shared<nfs::OpData<ResponseContents>>(routing::Parameters::group_size - 1,
-                                                               response_functor));
+                                                               std::move(callback)));
   auto task_id(rpc_timers_.put_timer.NewTaskId());
+  auto name(data.name());
   rpc_timers_.put_timer.AddTask(
       timeout,
-      [op_data, data](ResponseContents put_response) {
-        LOG(kVerbose) << "MaidNodeNfs Put HandleResponseContents for "
-                      << HexSubstr(data.name().value);
-        op_data->HandleResponseContents(std::move(put_response));
+      [op_data, name, task_id, this](ResponseContents put_response) {
+        LOG(kVerbose) << "MaidNodeNfs Put HandleResponseContents for " << HexSubstr(name.value);
+        if (op_data->HandleResponseContents(std::move(put_response)))
+          rpc_timers_.put_timer.ReleaseTask(task_id);
       },
       routing::Parameters::group_size - 1, task_id);
   rpc_timers_.put_timer.PrintTaskIds();
   dispatcher_.SendPutRequest(task_id, data);
-  return promise->get_future();
+}
+
+template <typename Data>
+std::vector<boost::future<void>> MaidNodeNfs::PutMany(
+    const std::vector<Data>& data, const std::chrono::steady_clock::duration& timeout) {
+  LOG(kVerbose) << "MaidNodeNfs PutMany " << data.size() << " chunks";
+  std::vector<boost::future<void>> futures;
+  futures.reserve(data.size());
+  std::vector<nfs_vault::DataNameAndContent> batch;
+  PutPromises promises;
+  size_t batch_content_size(0);
+  for (const auto& chunk : data) {
+    nfs_vault::DataNameAndContent data_name_and_content(chunk);
+    if (!batch.empty() &&
+        batch_content_size + data_name_and_content.content.size() > kMaxPutBatchContentSize) {
+      PutBatch(std::move(batch), std::move(promises), timeout);
+      batch.clear();
+      promises.clear();
+      batch_content_size = 0;
+    }
+    batch_content_size += data_name_and_content.content.size();
+    batch.push_back(std::move(data_name_and_content));
+    promises.push_back(std::make_shared<boost::promise<void>>());
+    futures.push_back(promises.back()->get_future());
+  }
+  if (!batch.empty())
+    PutBatch(std::move(batch), std::move(promises), timeout);
+  return futures;
+}
+
+template <typename Data>
+boost::future<void> MaidNodeNfs::PutPipelined(
+    std::function<boost::optional<Data>()> next_chunk, size_t max_in_flight,
+    std::function<void(const typename Data::Name&, const maidsafe_error&)> on_result,
+    const std::chrono::steady_clock::duration& timeout) {
+  if (!next_chunk || max_in_flight == 0)
+    BOOST_THROW_EXCEPTION(MakeError(CommonErrors::invalid_parameter));
+  auto state(std::make_shared<PipelinedPut<Data>>(std::move(next_chunk), max_in_flight,
+                                                  std::move(on_result), timeout));
+  auto future(state->promise.get_future());
+  PumpPipelinedPut(state);
+  return future;
+}
+
+template <typename InputIterator>
+boost::future<void> MaidNodeNfs::PutPipelined(
+    InputIterator first, InputIterator last, size_t max_in_flight,
+    std::function<void(const typename std::iterator_traits<InputIterator>::value_type::Name&,
+                       const maidsafe_error&)> on_result,
+    const std::chrono::steady_clock::duration& timeout) {
+  typedef typename std::iterator_traits<InputIterator>::value_type Data;
+  std::function<boost::optional<Data>()> next_chunk([first, last]() mutable {
+    return first == last ? boost::optional<Data>() : boost::optional<Data>(*first++);
+  });
+  return PutPipelined<Data>(std::move(next_chunk), max_in_flight, std::move(on_result), timeout);
+}
+
+template <typename Data>
+void MaidNodeNfs::PumpPipelinedPut(std::shared_ptr<PipelinedPut<Data>> state) {
+  for (;;) {
+    boost::optional<Data> chunk;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->exhausted || state->in_flight == state->max_in_flight)
+        break;
+      // 'next_chunk' is only called under the lock, so never concurrently.
+      try {
+        chunk = state->next_chunk();
+      }
+      catch (...) {
+        LOG(kError) << "MaidNodeNfs PutPipelined failed to produce a chunk";
+        if (!state->first_failure)
+          state->first_failure = boost::current_exception();
+      }
+      if (!chunk) {
+        state->exhausted = true;
+        break;
+      }
+      ++state->in_flight;
+    }
+    auto name(chunk->name());
+    // Set by whichever of the Put's callback and a failure to send the Put comes first, so that the
+    // Put is only counted out once (SendPut can throw after adding the Put's timer task).
+    auto settled(std::make_shared<std::atomic<bool>>(false));
+    std::shared_ptr<MaidNodeNfs> this_ptr(shared_from_this());
+    try {
+      SendPut(*chunk, [this_ptr, state, name, settled](const ReturnCode& result) {
+        if (settled->exchange(true))
+          return;
+        if (state->on_result)
+          state->on_result(name, result.value);
+        {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          --state->in_flight;
+          if (!nfs::IsSuccess(result) && !state->first_failure)
+            state->first_failure = boost::copy_exception(result.value);
+        }
+        // Posted, since this is called from within the Put timer's handling of the response.
+        this_ptr->asio_service_.service().post([this_ptr, state] {
+          this_ptr->PumpPipelinedPut(state);
+        });
+      }, state->timeout);
+    }
+    catch (...) {
+      LOG(kError) << "MaidNodeNfs PutPipelined failed to send Put for " << HexSubstr(name.value);
+      if (settled->exchange(true))
+        continue;
+      std::lock_guard<std::mutex> lock(state->mutex);
+      --state->in_flight;
+      if (!state->first_failure)
+        state->first_failure = boost::current_exception();
+    }
+  }
+
+  boost::exception_ptr failure;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (!state->exhausted || state->in_flight != 0 || state->completed)
+      return;
+    state->completed = true;
+    failure = state->first_failure;
+  }
+  if (failure)
+    state->promise.set_exception(failure);
+  else
+    state->promise.set_value();
 }
 
 template <typename DataName>
@@ -254,10 +488,11 @@ boost::future<void> MaidNodeNfs::CreateVersionTree(const DataName& data_name,
   auto task_id(rpc_timers_.create_version_tree_timer.NewTaskId());
   rpc_timers_.create_version_tree_timer.AddTask(
       timeout,
-      [op_data, data_name](ResponseContents get_response) {
+      [op_data, data_name, task_id, this](ResponseContents get_response) {
         LOG(kVerbose) << "MaidNodeNfs CreateVersionTree HandleResponseContents for "
                       << HexSubstr(data_name.value);
-        op_data->HandleResponseContents(std::move(get_response));
+        if (op_data->HandleResponseContents(std::move(get_response)))
+          rpc_timers_.create_version_tree_timer.ReleaseTask(task_id);
       },
       routing::Parameters::group_size * 3, task_id);
   rpc_timers_.create_version_tree_timer.PrintTaskIds();
@@ -272,20 +507,47 @@ MaidNodeNfs::VersionNamesFuture MaidNodeNfs::GetVersions(
   LOG(kVerbose) << "MaidNodeNfs Get Version for " << HexSubstr(data_name.value);
   typedef MaidNodeService::GetVersionsResponse::Contents ResponseContents;
   auto promise(std::make_shared<VersionNamesPromise>());
-  auto response_functor([promise](const StructuredDataNameAndContentOrReturnCode&
-                                  result) { HandleGetVersionsOrBranchResult(result, promise); });
+  auto response_functor([promise](StructuredDataNameAndContentOrReturnCode result) {
+                           HandleGetVersionsOrBranchResult(std::move(result), promise);
+                        });
   auto op_data(std::make_shared<nfs::OpData<ResponseContents>>(1, response_functor));
   auto task_id(rpc_timers_.get_versions_timer.NewTaskId());
   rpc_timers_.get_versions_timer.AddTask(
-      timeout, [op_data](ResponseContents get_versions_response) {
-                 op_data->HandleResponseContents(std::move(get_versions_response));
-               },
+      timeout,
+      [op_data, task_id, this](ResponseContents get_versions_response) {
+        if (op_data->HandleResponseContents(std::move(get_versions_response)))
+          rpc_timers_.get_versions_timer.ReleaseTask(task_id);
+      },
       // TODO(Fraser#5#): 2013-08-18 - Confirm expected count
       routing::Parameters::group_size * 2, task_id);
   dispatcher_.SendGetVersionsRequest(task_id, data_name);
   return promise->get_future();
 }
 
+template <typename DataName>
+MaidNodeNfs::VersionNamesFuture MaidNodeNfs::GetVersionsSince(
+    const DataName& data_name, const StructuredDataVersions::VersionName& last_known_version,
+    const std::chrono::steady_clock::duration& timeout) {
+  LOG(kVerbose) << "MaidNodeNfs Get Versions since " << DebugId(last_known_version.id)
+                << " for " << HexSubstr(data_name.value);
+  typedef MaidNodeService::GetVersionsResponse::Contents ResponseContents;
+  auto promise(std::make_shared<VersionNamesPromise>());
+  auto response_functor([promise](StructuredDataNameAndContentOrReturnCode result) {
+                           HandleGetVersionsOrBranchResult(std::move(result), promise);
+                        });
+  auto op_data(std::make_shared<nfs::OpData<ResponseContents>>(1, response_functor));
+  auto task_id(rpc_timers_.get_versions_timer.NewTaskId());
+  rpc_timers_.get_versions_timer.AddTask(
+      timeout,
+      [op_data, task_id, this](ResponseContents get_versions_response) {
+        if (op_data->HandleResponseContents(std::move(get_versions_response)))
+          rpc_timers_.get_versions_timer.ReleaseTask(task_id);
+      },
+      routing::Parameters::group_size * 2, task_id);
+  dispatcher_.SendGetVersionsSinceRequest(task_id, data_name, last_known_version);
+  return promise->get_future();
+}
+
 template <typename DataName>
 MaidNodeNfs::VersionNamesFuture MaidNodeNfs::GetBranch(
     const DataName& data_name, const StructuredDataVersions::VersionName& branch_tip,
@@ -293,17 +555,43 @@ MaidNodeNfs::VersionNamesFuture MaidNodeNfs::GetBranch(
   LOG(kVerbose) << "MaidNodeNfs Get Branch for " << HexSubstr(data_name.value);
   typedef MaidNodeService::GetBranchResponse::Contents ResponseContents;
   auto promise(std::make_shared<VersionNamesPromise>());
-  auto response_functor([promise](const StructuredDataNameAndContentOrReturnCode &
-                                  result) { HandleGetVersionsOrBranchResult(result, promise); });
+  auto response_functor([promise](StructuredDataNameAndContentOrReturnCode result) {
+                           HandleGetVersionsOrBranchResult(std::move(result), promise);
+                        });
   auto op_data(std::make_shared<nfs::OpData<ResponseContents>>(1, response_functor));
   auto task_id(rpc_timers_.get_branch_timer.NewTaskId());
   rpc_timers_.get_branch_timer.AddTask(timeout,
-      [op_data](ResponseContents get_branch_response) {
-          op_data->HandleResponseContents(std::move(get_branch_response));
+      [op_data, task_id, this](ResponseContents get_branch_response) {
+        if (op_data->HandleResponseContents(std::move(get_branch_response)))
+          rpc_timers_.get_branch_timer.ReleaseTask(task_id);
       },
       // TODO(Fraser#5#): 2013-08-18 - Confirm expected count
       routing::Parameters::group_size * 2, task_id);
-  dispatcher_.SendGetBranchRequest(task_id, data_name, branch_tip);
+  dispatcher_.SendGetBranchRequest(task_id, data_name, branch_tip, 0);
+  return promise->get_future();
+}
+
+template <typename DataName>
+MaidNodeNfs::BranchPageFuture MaidNodeNfs::GetBranch(
+    const DataName& data_name, const StructuredDataVersions::VersionName& page_start,
+    uint32_t limit, const std::chrono::steady_clock::duration& timeout) {
+  if (limit == 0 || limit == std::numeric_limits<uint32_t>::max())
+    BOOST_THROW_EXCEPTION(MakeError(CommonErrors::invalid_parameter));
+  typedef MaidNodeService::GetBranchResponse::Contents ResponseContents;
+  auto promise(std::make_shared<boost::promise<BranchPage>>());
+  auto response_functor([promise, limit](StructuredDataNameAndContentOrReturnCode result) {
+                          HandleGetBranchPageResult(std::move(result), limit, promise);
+                        });
+  auto op_data(std::make_shared<nfs::OpData<ResponseContents>>(1, response_functor));
+  auto task_id(rpc_timers_.get_branch_timer.NewTaskId());
+  rpc_timers_.get_branch_timer.AddTask(timeout,
+      [op_data, task_id, this](ResponseContents get_branch_response) {
+        if (op_data->HandleResponseContents(std::move(get_branch_response)))
+          rpc_timers_.get_branch_timer.ReleaseTask(task_id);
+      },
+      routing::Parameters::group_size * 2, task_id);
+  // One more version than the page holds is requested, to find the start of the next page.
+  dispatcher_.SendGetBranchRequest(task_id, data_name, page_start, limit + 1);
   return promise->get_future();
 }
 
@@ -325,11 +613,13 @@ MaidNodeNfs::PutVersionFuture MaidNodeNfs::PutVersion(
   auto task_id(rpc_timers_.put_version_timer.NewTaskId());
   rpc_timers_.put_version_timer.AddTask(
       timeout,
-      [op_data, data_name, new_version_name, old_version_name](ResponseContents get_response) {
+      [op_data, data_name, new_version_name, old_version_name, task_id,
+       this](ResponseContents get_response) {
         LOG(kVerbose) << "MaidNodeNfs PutVersion HandleResponseContents put new version "
                       << DebugId(new_version_name.id) << " after old version "
                       << DebugId(old_version_name.id) << " for " << HexSubstr(data_name.value);
-        op_data->HandleResponseContents(std::move(get_response));
+        if (op_data->HandleResponseContents(std::move(get_response)))
+          rpc_timers_.put_version_timer.ReleaseTask(task_id);
       },
       routing::Parameters::group_size * 3, task_id);
   rpc_timers_.put_version_timer.PrintTaskIds();
@@ -26,6 +26,7 @@
 #include "maidsafe/nfs/client/messages.h"
 #include "maidsafe/nfs/vault/messages.h"
 #include "maidsafe/nfs/client/get_handler.h"
+#include "maidsafe/nfs/client/rpc_timer.h"
 
 namespace maidsafe {
 
@@ -42,6 +43,7 @@ class MaidNodeService {
 
   typedef nfs::GetResponseFromDataManagerToMaidNode GetResponse;
   typedef nfs::PutResponseFromMaidManagerToMaidNode PutResponse;
+  typedef nfs::PutBatchResponseFromMaidManagerToMaidNode PutBatchResponse;
   typedef nfs::GetCachedResponseFromCacheHandlerToMaidNode GetCachedResponse;
   typedef nfs::PutFailureFromMaidManagerToMaidNode PutFailure;
   typedef nfs::GetVersionsResponseFromVersionHandlerToMaidNode GetVersionsResponse;
@@ -55,12 +57,13 @@ class MaidNodeService {
     void CancellAll();
 
     routing::Timer<GetResponse::Contents> get_timer;
-    routing::Timer<PutResponse::Contents> put_timer;
-    routing::Timer<GetVersionsResponse::Contents> get_versions_timer;
-    routing::Timer<GetBranchResponse::Contents> get_branch_timer;
-    routing::Timer<CreateAccountResponse::Contents> create_account_timer;
-    routing::Timer<CreateVersionTreeResponse::Contents> create_version_tree_timer;
-    routing::Timer<PutVersionResponse::Contents> put_version_timer;
+    RpcTimer<PutResponse::Contents> put_timer;
+    RpcTimer<PutBatchResponse::Contents> put_batch_timer;
+    RpcTimer<GetVersionsResponse::Contents> get_versions_timer;
+    RpcTimer<GetBranchResponse::Contents> get_branch_timer;
+    RpcTimer<CreateAccountResponse::Contents> create_account_timer;
+    RpcTimer<CreateVersionTreeResponse::Contents> create_version_tree_timer;
+    RpcTimer<PutVersionResponse::Contents> put_version_timer;
   };
 
 
@@ -74,6 +77,9 @@ class MaidNodeService {
   void HandleMessage(const PutResponse& message, const PutResponse::Sender& sender,
                      const PutResponse::Receiver& receiver);
 
+  void HandleMessage(const PutBatchResponse& message, const PutBatchResponse::Sender& sender,
+                     const PutBatchResponse::Receiver& receiver);
+
   void HandleMessage(const GetCachedResponse& message, const GetCachedResponse::Sender& sender,
                      const GetCachedResponse::Receiver& receiver);
 
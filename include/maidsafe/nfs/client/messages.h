@@ -19,7 +19,7 @@
 #ifndef MAIDSAFE_NFS_CLIENT_MESSAGES_H_
 #define MAIDSAFE_NFS_CLIENT_MESSAGES_H_
 
-#include <set>
+#include <algorithm>
 #include <string>
 #include <system_error>
 #include <type_traits>
@@ -56,7 +56,7 @@ struct ReturnCode {
 
   ReturnCode(const maidsafe_error& error = MakeError(CommonErrors::defaulted));
   ReturnCode(const ReturnCode& other);
-  ReturnCode(ReturnCode&& other);
+  ReturnCode(ReturnCode&& other) MAIDSAFE_NOEXCEPT;
   ReturnCode& operator=(ReturnCode other);
 
   explicit ReturnCode(const std::string& serialised_copy);
@@ -68,12 +68,18 @@ struct ReturnCode {
 bool operator==(const ReturnCode& lhs, const ReturnCode& rhs);
 void swap(ReturnCode& lhs, ReturnCode& rhs) MAIDSAFE_NOEXCEPT;
 
+// Peers which predate the numeric error category id can't parse a ReturnCode without its category
+// name.  While this is set (the default), serialised ReturnCodes carry the name alongside the id.
+// Once no such peers remain it should be cleared, after which the name is only written for
+// categories which have no id, so ReturnCodes are smaller and need no string to be allocated.
+void SetWriteErrorCategoryNames(bool write);
+
 // ==================== AvailableSizeAndReturnCode =================================================
 struct AvailableSizeAndReturnCode {
   AvailableSizeAndReturnCode();
   AvailableSizeAndReturnCode(uint64_t size, const ReturnCode& return_code);
   AvailableSizeAndReturnCode(const AvailableSizeAndReturnCode& other);
-  AvailableSizeAndReturnCode(AvailableSizeAndReturnCode&& other);
+  AvailableSizeAndReturnCode(AvailableSizeAndReturnCode&& other) MAIDSAFE_NOEXCEPT;
   AvailableSizeAndReturnCode& operator=(AvailableSizeAndReturnCode other);
 
   explicit AvailableSizeAndReturnCode(const std::string& serialised_copy);
@@ -94,7 +100,7 @@ struct DataNameAndReturnCode {
   DataNameAndReturnCode();
   DataNameAndReturnCode(nfs_vault::DataName data_name, ReturnCode code);
   DataNameAndReturnCode(const DataNameAndReturnCode& other);
-  DataNameAndReturnCode(DataNameAndReturnCode&& other);
+  DataNameAndReturnCode(DataNameAndReturnCode&& other) MAIDSAFE_NOEXCEPT;
   DataNameAndReturnCode& operator=(DataNameAndReturnCode other);
 
   explicit DataNameAndReturnCode(const std::string& serialised_copy);
@@ -116,7 +122,7 @@ struct DataNameAndSizeAndReturnCode {
   DataNameAndSizeAndReturnCode();
   DataNameAndSizeAndReturnCode(nfs_vault::DataName data_name, uint64_t size_in, ReturnCode code);
   DataNameAndSizeAndReturnCode(const DataNameAndSizeAndReturnCode& other);
-  DataNameAndSizeAndReturnCode(DataNameAndSizeAndReturnCode&& other);
+  DataNameAndSizeAndReturnCode(DataNameAndSizeAndReturnCode&& other) MAIDSAFE_NOEXCEPT;
   DataNameAndSizeAndReturnCode& operator=(DataNameAndSizeAndReturnCode other);
 
   explicit DataNameAndSizeAndReturnCode(const std::string& serialised_copy);
@@ -131,36 +137,74 @@ bool operator==(const DataNameAndSizeAndReturnCode& lhs, const DataNameAndSizeAn
 void swap(DataNameAndSizeAndReturnCode& lhs, DataNameAndSizeAndReturnCode& rhs) MAIDSAFE_NOEXCEPT;
 
 // ==================== DataNamesAndReturnCode =====================================================
+// The names are kept sorted and free of duplicates (as ordered by nfs_vault::DataName's operator<)
+// in a contiguous vector rather than a std::set, so that large lists are cheap to build and
+// serialise.  The vector is private to keep it sorted; use names() to read it.  AddDataName inserts
+// in place, which is linear in the size of the list; to build a large list, use the constructor or
+// AddDataNames, which sort once.
 struct DataNamesAndReturnCode {
   explicit DataNamesAndReturnCode(const ReturnCode& code);
-  DataNamesAndReturnCode(const std::vector<nfs_vault::DataName>& data_names,
-                         const ReturnCode& code);
+  DataNamesAndReturnCode(std::vector<nfs_vault::DataName> data_names, const ReturnCode& code);
   DataNamesAndReturnCode(const DataNamesAndReturnCode &other);
-  DataNamesAndReturnCode(DataNamesAndReturnCode&& other);
+  DataNamesAndReturnCode(DataNamesAndReturnCode&& other) MAIDSAFE_NOEXCEPT;
   DataNamesAndReturnCode& operator=(DataNamesAndReturnCode other);
 
   template<typename DataNameType>
   void AddDataName(const DataNameType& data_name) {
-    names.insert(nfs_vault::DataName(data_name));
+    AddDataName(nfs_vault::DataName(data_name));
   }
 
   void AddDataName(const DataTagValue& tag_value, const Identity& identity);
+  void AddDataName(nfs_vault::DataName data_name);
+
+  template<typename InputIterator>
+  void AddDataNames(InputIterator first, InputIterator last) {
+    names_.insert(std::end(names_), first, last);
+    SortNames();
+  }
+
+  bool Contains(const nfs_vault::DataName& data_name) const;
 
   explicit DataNamesAndReturnCode(const std::string& serialised_copy);
   std::string Serialise() const;
 
-  std::set<nfs_vault::DataName> names;
+  const std::vector<nfs_vault::DataName>& names() const { return names_; }
+
   ReturnCode return_code;
+
+ private:
+  friend void swap(DataNamesAndReturnCode& lhs, DataNamesAndReturnCode& rhs) MAIDSAFE_NOEXCEPT;
+  void SortNames();
+
+  std::vector<nfs_vault::DataName> names_;
 };
 
 bool operator==(const DataNamesAndReturnCode& lhs, const DataNamesAndReturnCode& rhs);
 void swap(DataNamesAndReturnCode& lhs, DataNamesAndReturnCode& rhs) MAIDSAFE_NOEXCEPT;
 
+// ==================== DataNameAndReturnCodes =====================================================
+// Holds a separate result for each of the names in a batched request.
+struct DataNameAndReturnCodes {
+  DataNameAndReturnCodes();
+  explicit DataNameAndReturnCodes(std::vector<DataNameAndReturnCode> results_in);
+  DataNameAndReturnCodes(const DataNameAndReturnCodes& other);
+  DataNameAndReturnCodes(DataNameAndReturnCodes&& other) MAIDSAFE_NOEXCEPT;
+  DataNameAndReturnCodes& operator=(DataNameAndReturnCodes other);
+
+  explicit DataNameAndReturnCodes(const std::string& serialised_copy);
+  std::string Serialise() const;
+
+  std::vector<DataNameAndReturnCode> results;
+};
+
+bool operator==(const DataNameAndReturnCodes& lhs, const DataNameAndReturnCodes& rhs);
+void swap(DataNameAndReturnCodes& lhs, DataNameAndReturnCodes& rhs) MAIDSAFE_NOEXCEPT;
+
 // ==================== DataNameVersionAndReturnCode ===============================================
 struct DataNameVersionAndReturnCode {
   DataNameVersionAndReturnCode();
   DataNameVersionAndReturnCode(const DataNameVersionAndReturnCode& other);
-  DataNameVersionAndReturnCode(DataNameVersionAndReturnCode&& other);
+  DataNameVersionAndReturnCode(DataNameVersionAndReturnCode&& other) MAIDSAFE_NOEXCEPT;
   DataNameVersionAndReturnCode& operator=(DataNameVersionAndReturnCode other);
 
   explicit DataNameVersionAndReturnCode(const std::string& serialised_copy);
@@ -177,7 +221,7 @@ void swap(DataNameVersionAndReturnCode& lhs, DataNameVersionAndReturnCode& rhs)
 struct DataNameOldNewVersionAndReturnCode {
   DataNameOldNewVersionAndReturnCode();
   DataNameOldNewVersionAndReturnCode(const DataNameOldNewVersionAndReturnCode& other);
-  DataNameOldNewVersionAndReturnCode(DataNameOldNewVersionAndReturnCode&& other);
+  DataNameOldNewVersionAndReturnCode(DataNameOldNewVersionAndReturnCode&& other) MAIDSAFE_NOEXCEPT;
   DataNameOldNewVersionAndReturnCode& operator=(DataNameOldNewVersionAndReturnCode other);
 
   explicit DataNameOldNewVersionAndReturnCode(const std::string& serialised_copy);
@@ -196,7 +240,7 @@ void swap(DataNameOldNewVersionAndReturnCode& lhs,
 struct DataAndReturnCode {
   DataAndReturnCode();
   DataAndReturnCode(const DataAndReturnCode& other);
-  DataAndReturnCode(DataAndReturnCode&& other);
+  DataAndReturnCode(DataAndReturnCode&& other) MAIDSAFE_NOEXCEPT;
   DataAndReturnCode& operator=(DataAndReturnCode other);
 
   explicit DataAndReturnCode(const std::string& serialised_copy);
@@ -222,7 +266,7 @@ struct DataNameAndContentOrReturnCode {
 
   DataNameAndContentOrReturnCode();
   DataNameAndContentOrReturnCode(const DataNameAndContentOrReturnCode& other);
-  DataNameAndContentOrReturnCode(DataNameAndContentOrReturnCode&& other);
+  DataNameAndContentOrReturnCode(DataNameAndContentOrReturnCode&& other) MAIDSAFE_NOEXCEPT;
   DataNameAndContentOrReturnCode& operator=(DataNameAndContentOrReturnCode other);
 
   explicit DataNameAndContentOrReturnCode(const std::string& serialised_copy);
@@ -246,7 +290,8 @@ void swap(DataNameAndContentOrReturnCode& lhs,
 struct StructuredDataNameAndContentOrReturnCode {
   StructuredDataNameAndContentOrReturnCode();
   StructuredDataNameAndContentOrReturnCode(const StructuredDataNameAndContentOrReturnCode& other);
-  StructuredDataNameAndContentOrReturnCode(StructuredDataNameAndContentOrReturnCode&& other);
+  StructuredDataNameAndContentOrReturnCode(
+      StructuredDataNameAndContentOrReturnCode&& other) MAIDSAFE_NOEXCEPT;
   StructuredDataNameAndContentOrReturnCode& operator=(
       StructuredDataNameAndContentOrReturnCode other);
 
@@ -267,7 +312,7 @@ struct TipOfTreeAndReturnCode {
   TipOfTreeAndReturnCode();
   explicit TipOfTreeAndReturnCode(const ReturnCode return_code_in);
   TipOfTreeAndReturnCode(const TipOfTreeAndReturnCode& other);
-  TipOfTreeAndReturnCode(TipOfTreeAndReturnCode&& other);
+  TipOfTreeAndReturnCode(TipOfTreeAndReturnCode&& other) MAIDSAFE_NOEXCEPT;
   TipOfTreeAndReturnCode& operator=(TipOfTreeAndReturnCode other);
 
   explicit TipOfTreeAndReturnCode(const std::string& serialised_copy);
@@ -313,7 +358,8 @@ struct DataNameAndSizeAndSpaceAndReturnCode {
   explicit DataNameAndSizeAndSpaceAndReturnCode(const std::string& serialised_copy);
   DataNameAndSizeAndSpaceAndReturnCode();
   DataNameAndSizeAndSpaceAndReturnCode(const DataNameAndSizeAndSpaceAndReturnCode& other);
-  DataNameAndSizeAndSpaceAndReturnCode(DataNameAndSizeAndSpaceAndReturnCode&& other);
+  DataNameAndSizeAndSpaceAndReturnCode(
+      DataNameAndSizeAndSpaceAndReturnCode&& other) MAIDSAFE_NOEXCEPT;
   DataNameAndSizeAndSpaceAndReturnCode& operator=(DataNameAndSizeAndSpaceAndReturnCode other);
   std::string Serialise() const;
 
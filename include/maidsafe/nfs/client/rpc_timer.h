@@ -0,0 +1,160 @@
+/*  Copyright 2013 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#ifndef MAIDSAFE_NFS_CLIENT_RPC_TIMER_H_
+#define MAIDSAFE_NFS_CLIENT_RPC_TIMER_H_
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+
+#include "maidsafe/common/asio_service.h"
+#include "maidsafe/common/error.h"
+#include "maidsafe/common/log.h"
+#include "maidsafe/routing/timer.h"
+
+#include "maidsafe/nfs/lazy_contents.h"
+
+namespace maidsafe {
+
+namespace nfs_client {
+
+// A routing::Timer whose tasks can be released as soon as the operation has its result (e.g. once
+// an OpData reaches quorum), rather than being held until the expected number of responses has
+// arrived or the timeout has expired.  Responses which arrive for a released task are dropped
+// without being parsed.  Only the most recently released kMaxReleasedTasks are remembered; later
+// responses to older ones are handed to the timer, which rejects them as before.
+template <typename Response>
+class RpcTimer {
+ public:
+  static const size_t kMaxReleasedTasks = 1024;
+
+  explicit RpcTimer(AsioService& asio_service);
+  ~RpcTimer();
+
+  routing::TaskId NewTaskId() { return timer_.NewTaskId(); }
+
+  void AddTask(const std::chrono::steady_clock::duration& timeout,
+               std::function<void(Response)> response_functor, int expected_response_count,
+               routing::TaskId task_id);
+
+  // Throws as routing::Timer::AddResponse, unless the task has been released.
+  void AddResponse(routing::TaskId task_id, const nfs::LazyContents<Response>& response);
+
+  // Frees the timer's slot for 'task_id'.  Can be called from the task's response functor.
+  void ReleaseTask(routing::TaskId task_id);
+
+  void CancelAll() { timer_.CancelAll(); }
+  void PrintTaskIds() { timer_.PrintTaskIds(); }
+
+ private:
+  // Shared with the cancellations which ReleaseTask posts to asio, which can run after the RpcTimer
+  // has been destroyed.  They only use the RpcTimer while holding 'mutex' and if 'stopped' is
+  // false, and the destructor sets 'stopped'.
+  struct AsyncGuard {
+    AsyncGuard() : mutex(), stopped(false) {}
+    std::mutex mutex;
+    bool stopped;
+  };
+
+  RpcTimer(const RpcTimer&);
+  RpcTimer(RpcTimer&&);
+  RpcTimer& operator=(RpcTimer);
+
+  AsioService& asio_service_;
+  routing::Timer<Response> timer_;
+  std::shared_ptr<AsyncGuard> async_guard_;
+  std::mutex mutex_;
+  std::unordered_set<routing::TaskId> released_tasks_;
+  std::deque<routing::TaskId> release_order_;
+};
+
+// ==================== Implementation =============================================================
+template <typename Response>
+const size_t RpcTimer<Response>::kMaxReleasedTasks;
+
+template <typename Response>
+RpcTimer<Response>::RpcTimer(AsioService& asio_service)
+    : asio_service_(asio_service), timer_(asio_service),
+      async_guard_(std::make_shared<AsyncGuard>()), mutex_(), released_tasks_(),
+      release_order_() {}
+
+template <typename Response>
+RpcTimer<Response>::~RpcTimer() {
+  std::lock_guard<std::mutex> guard_lock(async_guard_->mutex);
+  async_guard_->stopped = true;
+}
+
+template <typename Response>
+void RpcTimer<Response>::AddTask(const std::chrono::steady_clock::duration& timeout,
+                                 std::function<void(Response)> response_functor,
+                                 int expected_response_count, routing::TaskId task_id) {
+  timer_.AddTask(timeout, std::move(response_functor), expected_response_count, task_id);
+}
+
+template <typename Response>
+void RpcTimer<Response>::AddResponse(routing::TaskId task_id,
+                                     const nfs::LazyContents<Response>& response) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (released_tasks_.count(task_id) != 0) {
+      LOG(kVerbose) << "Dropping late response for released task " << task_id;
+      return;
+    }
+  }
+  timer_.AddResponse(task_id, *response);
+}
+
+template <typename Response>
+void RpcTimer<Response>::ReleaseTask(routing::TaskId task_id) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!released_tasks_.insert(task_id).second)
+      return;
+    release_order_.push_back(task_id);
+    if (release_order_.size() > kMaxReleasedTasks) {
+      released_tasks_.erase(release_order_.front());
+      release_order_.pop_front();
+    }
+  }
+  // Cancelling is posted, since the timer may be running this task's functor on this thread.
+  auto async_guard(async_guard_);
+  asio_service_.service().post([this, task_id, async_guard] {
+    std::lock_guard<std::mutex> guard_lock(async_guard->mutex);
+    if (async_guard->stopped)
+      return;
+    try {
+      timer_.CancelTask(task_id);
+    }
+    catch (const maidsafe_error& error) {
+      // The task may have completed or timed out in the meantime.
+      LOG(kVerbose) << "Releasing task " << task_id << ": " << error.what();
+    }
+  });
+}
+
+}  // namespace nfs_client
+
+}  // namespace maidsafe
+
+#endif  // MAIDSAFE_NFS_CLIENT_RPC_TIMER_H_
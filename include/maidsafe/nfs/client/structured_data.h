@@ -19,6 +19,8 @@
 #ifndef MAIDSAFE_NFS_CLIENT_STRUCTURED_DATA_H_
 #define MAIDSAFE_NFS_CLIENT_STRUCTURED_DATA_H_
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -35,18 +37,40 @@ struct StructuredData {
 
   StructuredData();
   StructuredData(const StructuredData& other);
-  StructuredData(StructuredData&& other);
+  StructuredData(StructuredData&& other) MAIDSAFE_NOEXCEPT;
   StructuredData& operator=(StructuredData other);
 
   explicit StructuredData(const std::string& serialised_copy);
   std::string Serialise() const;
 
-  std::vector<StructuredDataVersions::VersionName> versions;
+  const std::vector<StructuredDataVersions::VersionName>& versions() const { return versions_; }
+  // Invalidates the cached digest.  The returned reference mustn't be used to modify the versions
+  // after a subsequent call to digest() or operator==.
+  std::vector<StructuredDataVersions::VersionName>& mutable_versions();
+
+  // Order-independent digest of the versions, calculated on first use and cached until the
+  // versions are next modified.  Equal StructuredData have equal digests, so comparing digests
+  // rejects most unequal but differently ordered responses without sorting them.
+  uint64_t digest() const;
+
+  friend void swap(StructuredData& lhs, StructuredData& rhs) MAIDSAFE_NOEXCEPT;
+
+ private:
+  std::vector<StructuredDataVersions::VersionName> versions_;
+  // Concurrent calls to digest() may each calculate it, but they store the same value.
+  mutable std::atomic<uint64_t> digest_;
+  mutable std::atomic<bool> has_digest_;
 };
 
 bool operator==(const StructuredData& lhs, const StructuredData& rhs);
 void swap(StructuredData& lhs, StructuredData& rhs) MAIDSAFE_NOEXCEPT;
 
+// Peers which predate the packed encoding of versions can only parse StructuredData holding each
+// version serialised separately.  While this is cleared (the default), that is the only encoding
+// written.  Once no such peers remain it should be set, after which the packed encoding is written
+// instead wherever the versions allow it.  Both encodings are always parsed.
+void SetWritePackedVersions(bool write);
+
 }  // namespace nfs_client
 
 }  // namespace maidsafe
@@ -0,0 +1,120 @@
+/*  Copyright 2013 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#ifndef MAIDSAFE_NFS_LAZY_CONTENTS_H_
+#define MAIDSAFE_NFS_LAZY_CONTENTS_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "maidsafe/common/config.h"
+#include "maidsafe/common/error.h"
+
+namespace maidsafe {
+
+namespace nfs {
+
+// Shared holder for the contents of a MessageWrapper.  Contents received from the network are kept
+// in serialised form and only parsed the first time they are dereferenced, so messages which are
+// dropped (e.g. duplicate or late group responses) are never decoded.  Copies share the same
+// (possibly not yet parsed) contents, as copies of the previous std::shared_ptr member did.
+// Parsing errors are thrown from the first dereference rather than from the MessageWrapper
+// constructor.
+template <typename ContentsType>
+class LazyContents {
+ public:
+  LazyContents() : state_() {}
+
+  explicit LazyContents(ContentsType contents) : state_(std::make_shared<State>()) {
+    state_->contents.reset(new ContentsType(std::move(contents)));
+  }
+
+  explicit LazyContents(std::string serialised_contents) : state_(std::make_shared<State>()) {
+    state_->serialised_contents = std::move(serialised_contents);
+    state_->has_serialised_contents = true;
+  }
+
+  LazyContents(const LazyContents& other) : state_(other.state_) {}
+  LazyContents(LazyContents&& other) MAIDSAFE_NOEXCEPT : state_(std::move(other.state_)) {}
+  LazyContents& operator=(LazyContents other) {
+    swap(*this, other);
+    return *this;
+  }
+
+  const ContentsType& operator*() const { return *get(); }
+  const ContentsType* operator->() const { return get(); }
+  // Non-const access may modify the contents, so the received bytes are no longer used by
+  // Serialise once it has been requested.
+  ContentsType& operator*() { return *mutable_get(); }
+  ContentsType* operator->() { return mutable_get(); }
+  explicit operator bool() const { return static_cast<bool>(state_); }
+
+  // Parses the contents if this hasn't already been done.  Returns nullptr if empty.
+  const ContentsType* get() const { return Parse(); }
+
+  // As above, but also discards the received bytes.  Copies share the contents, so see the change.
+  ContentsType* mutable_get() {
+    ContentsType* contents(Parse());
+    if (contents)
+      state_->has_serialised_contents = false;
+    return contents;
+  }
+
+  // Returns the received bytes unchanged where available, avoiding a parse and re-serialise.
+  std::string Serialise() const {
+    if (!state_)
+      BOOST_THROW_EXCEPTION(MakeError(CommonErrors::uninitialised));
+    return state_->has_serialised_contents ? state_->serialised_contents : get()->Serialise();
+  }
+
+  friend void swap(LazyContents& lhs, LazyContents& rhs) {
+    using std::swap;
+    swap(lhs.state_, rhs.state_);
+  }
+
+ private:
+  struct State {
+    State() : parse_flag(), serialised_contents(), has_serialised_contents(false), contents() {}
+    std::once_flag parse_flag;
+    std::string serialised_contents;
+    std::atomic<bool> has_serialised_contents;
+    std::unique_ptr<ContentsType> contents;
+  };
+
+  ContentsType* Parse() const {
+    if (!state_)
+      return nullptr;
+    State& state(*state_);
+    std::call_once(state.parse_flag, [&state] {
+      if (!state.contents)
+        state.contents.reset(new ContentsType(state.serialised_contents));
+    });
+    return state.contents.get();
+  }
+
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace nfs
+
+}  // namespace maidsafe
+
+#endif  // MAIDSAFE_NFS_LAZY_CONTENTS_H_
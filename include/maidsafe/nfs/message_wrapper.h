@@ -29,6 +29,7 @@
 #include "maidsafe/common/utils.h"
 #include "maidsafe/common/tagged_value.h"
 
+#include "maidsafe/nfs/lazy_contents.h"
 #include "maidsafe/nfs/types.h"
 
 namespace maidsafe {
@@ -55,6 +56,7 @@ struct MessageWrapper {
   typedef DestinationPersonaType DestinationPersona;
   typedef RoutingReceiverType Receiver;
   typedef ContentsType Contents;
+  static const MessageAction kAction = action;
   struct Tag;
   typedef boost::error_info<Tag, MessageWrapper> ErrorInfo;
 
@@ -92,11 +94,14 @@ struct MessageWrapper {
   }
 
   MessageId id;
-  std::shared_ptr<ContentsType> contents;
+  LazyContents<ContentsType> contents;
 
  private:
   static const detail::SourceTaggedValue kSourceTaggedValue;
   static const detail::DestinationTaggedValue kDestinationTaggedValue;
+  // Encoded action, source and destination fields, which are identical for every message of this
+  // type, so are only serialised once.
+  static const std::string kSerialisedHeader;
 };
 
 template <MessageAction action, typename SourcePersonaType, typename RoutingSenderType,
@@ -129,8 +134,24 @@ MessageId GetNewMessageId();
 
 std::string SerialiseMessageWrapper(const TypeErasedMessageWrapper& message_tuple);
 
+// Returns the encoding of the fields preceding the message id, to be passed to the overload below.
+// Doesn't use protobuf, since it is called during static initialisation.
+std::string SerialiseMessageWrapperHeader(MessageAction action, Persona source_persona,
+                                          Persona destination_persona);
+
+// Produces the same bytes as the overload above, by appending the id and contents to the cached
+// header rather than populating a protobuf object.
+std::string SerialiseMessageWrapper(const std::string& serialised_header, MessageId message_id,
+                                    const std::string& serialised_contents);
+
 }  // namespace detail
 
+template <MessageAction action, typename SourcePersonaType, typename RoutingSenderType,
+          typename DestinationPersonaType, typename RoutingReceiverType, typename ContentsType>
+const MessageAction MessageWrapper<action, SourcePersonaType, RoutingSenderType,
+                                   DestinationPersonaType, RoutingReceiverType,
+                                   ContentsType>::kAction;
+
 template <MessageAction action, typename SourcePersonaType, typename RoutingSenderType,
           typename DestinationPersonaType, typename RoutingReceiverType, typename ContentsType>
 const detail::SourceTaggedValue MessageWrapper<
@@ -144,6 +165,14 @@ const detail::DestinationTaggedValue
                    RoutingReceiverType, ContentsType>::kDestinationTaggedValue =
         detail::DestinationTaggedValue(DestinationPersonaType::value);
 
+template <MessageAction action, typename SourcePersonaType, typename RoutingSenderType,
+          typename DestinationPersonaType, typename RoutingReceiverType, typename ContentsType>
+const std::string
+    MessageWrapper<action, SourcePersonaType, RoutingSenderType, DestinationPersonaType,
+                   RoutingReceiverType, ContentsType>::kSerialisedHeader =
+        detail::SerialiseMessageWrapperHeader(action, SourcePersonaType::value,
+                                              DestinationPersonaType::value);
+
 template <MessageAction action, typename SourcePersonaType, typename RoutingSenderType,
           typename DestinationPersonaType, typename RoutingReceiverType, typename ContentsType>
 MessageWrapper<action, SourcePersonaType, RoutingSenderType, DestinationPersonaType,
@@ -154,14 +183,14 @@ template <MessageAction action, typename SourcePersonaType, typename RoutingSend
           typename DestinationPersonaType, typename RoutingReceiverType, typename ContentsType>
 MessageWrapper<action, SourcePersonaType, RoutingSenderType, DestinationPersonaType,
                RoutingReceiverType, ContentsType>::MessageWrapper(const ContentsType& contents_in)
-    : id(detail::GetNewMessageId()), contents(std::make_shared<ContentsType>(contents_in)) {}
+    : id(detail::GetNewMessageId()), contents(contents_in) {}
 
 template <MessageAction action, typename SourcePersonaType, typename RoutingSenderType,
           typename DestinationPersonaType, typename RoutingReceiverType, typename ContentsType>
 MessageWrapper<action, SourcePersonaType, RoutingSenderType, DestinationPersonaType,
                RoutingReceiverType, ContentsType>::MessageWrapper(MessageId message_id,
                                                                   ContentsType contents_in)
-    : id(std::move(message_id)), contents(std::make_shared<ContentsType>(contents_in)) {}
+    : id(std::move(message_id)), contents(std::move(contents_in)) {}
 
 template <MessageAction action, typename SourcePersonaType, typename RoutingSenderType,
           typename DestinationPersonaType, typename RoutingReceiverType, typename ContentsType>
@@ -169,7 +198,7 @@ MessageWrapper<action, SourcePersonaType, RoutingSenderType, DestinationPersonaT
                RoutingReceiverType,
                ContentsType>::MessageWrapper(const TypeErasedMessageWrapper& parsed_message_wrapper)
     : id(std::get<3>(parsed_message_wrapper)),
-      contents(std::make_shared<ContentsType>(std::get<4>(parsed_message_wrapper))) {}
+      contents(std::get<4>(parsed_message_wrapper)) {}
 
 template <MessageAction action, typename SourcePersonaType, typename RoutingSenderType,
           typename DestinationPersonaType, typename RoutingReceiverType, typename ContentsType>
@@ -198,8 +227,7 @@ template <MessageAction action, typename SourcePersonaType, typename RoutingSend
           typename DestinationPersonaType, typename RoutingReceiverType, typename ContentsType>
 std::string MessageWrapper<action, SourcePersonaType, RoutingSenderType, DestinationPersonaType,
                            RoutingReceiverType, ContentsType>::Serialise() const {
-  return detail::SerialiseMessageWrapper(std::make_tuple(
-      action, kSourceTaggedValue, kDestinationTaggedValue, id, contents->Serialise()));
+  return detail::SerialiseMessageWrapper(kSerialisedHeader, id, contents.Serialise());
 }
 
 template <MessageAction action, typename SourcePersonaType, typename RoutingSenderType,
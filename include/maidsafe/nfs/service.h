@@ -19,12 +19,23 @@
 #ifndef MAIDSAFE_NFS_SERVICE_H_
 #define MAIDSAFE_NFS_SERVICE_H_
 
+#include <array>
+#include <cassert>
+#include <cstdint>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 
-#include "boost/variant/static_visitor.hpp"
+#include "boost/exception/diagnostic_information.hpp"
+#include "boost/mpl/for_each.hpp"
+#include "boost/mpl/placeholders.hpp"
+#include "boost/mpl/vector.hpp"
+#include "boost/type_traits/add_pointer.hpp"
 #include "boost/variant/variant.hpp"
 
+#include "maidsafe/common/error.h"
+#include "maidsafe/common/log.h"
+
 #include "maidsafe/routing/api_config.h"
 
 #include "maidsafe/nfs/message_types.h"
@@ -35,50 +46,114 @@
 
 namespace maidsafe {
 
-namespace vault {
-
-template <typename T>
-inline bool GetVariant(const maidsafe::nfs::TypeErasedMessageWrapper& message, T& variant);
-
-}  // namespace vault
-
 namespace nfs {
 
 namespace detail {
 
+template <typename Messages>
+struct MessageTypes {
+  typedef typename Messages::types type;
+};
+
+template <>
+struct MessageTypes<void> {
+  typedef boost::mpl::vector<> type;
+};
+
+const size_t kMessageActionCount(static_cast<size_t>(MessageAction::kNoOperation) + 1);
+const size_t kPersonaCount(static_cast<size_t>(Persona::kNA) + 1);
+const size_t kDispatchTableSize(kMessageActionCount * kPersonaCount * kPersonaCount);
+
+// Returns kDispatchTableSize if any of the values is outside the range of its enum.
+inline size_t DispatchIndex(MessageAction action, Persona source_persona,
+                            Persona destination_persona) {
+  auto action_value(static_cast<int32_t>(action));
+  auto source_value(static_cast<int32_t>(source_persona));
+  auto destination_value(static_cast<int32_t>(destination_persona));
+  if (action_value < 0 || static_cast<size_t>(action_value) >= kMessageActionCount ||
+      source_value < 0 || static_cast<size_t>(source_value) >= kPersonaCount ||
+      destination_value < 0 || static_cast<size_t>(destination_value) >= kPersonaCount) {
+    return kDispatchTableSize;
+  }
+  return (static_cast<size_t>(action_value) * kPersonaCount + static_cast<size_t>(source_value)) *
+             kPersonaCount + static_cast<size_t>(destination_value);
+}
+
+// Maps (action, source persona, destination persona) of an incoming message directly to the typed
+// handler of PersonaService.  The table is populated once from the types listed in the
+// PublicMessages and VaultMessages variants (i.e. from the cmake/*.message_types.meta files), so
+// handling a message needs neither trial-parsing of the variants nor exceptions.  Only message
+// types whose routing Sender and Receiver match this table's are registered.  If a type appears in
+// both variants, the public one takes precedence.
 template <typename PersonaService, typename Sender, typename Receiver>
-class PersonaDemuxer : public boost::static_visitor<
-                           typename PersonaService::HandleMessageReturnType> {
+class DispatchTable {
  public:
-  PersonaDemuxer(PersonaService& persona_service, const Sender& sender, const Receiver& receiver)
-      : persona_service_(persona_service), sender_(sender), receiver_(receiver) {}
+  typedef typename PersonaService::HandleMessageReturnType ReturnType;
+  typedef ReturnType (*Handler)(PersonaService&, const TypeErasedMessageWrapper&, const Sender&,
+                                const Receiver&);
+
+  // The one table for this combination.  It is a static data member rather than a function-local
+  // static so that it is built during static initialisation, since not all supported compilers
+  // make the initialisation of function-local statics thread-safe.
+  static const DispatchTable kInstance;
+
+  DispatchTable() : handlers_() {
+    handlers_.fill(nullptr);
+    boost::mpl::for_each<typename MessageTypes<typename PersonaService::PublicMessages>::type,
+                         boost::add_pointer<boost::mpl::_1>>(Registrar(handlers_));
+    boost::mpl::for_each<typename MessageTypes<typename PersonaService::VaultMessages>::type,
+                         boost::add_pointer<boost::mpl::_1>>(Registrar(handlers_));
+  }
+
+  // Returns nullptr if no handler is registered for the message.
+  Handler Find(const TypeErasedMessageWrapper& message) const {
+    auto index(DispatchIndex(std::get<0>(message), std::get<1>(message).data,
+                             std::get<2>(message).data));
+    return index < handlers_.size() ? handlers_[index] : nullptr;
+  }
+
+ private:
+  typedef std::array<Handler, kDispatchTableSize> Handlers;
+
+  class Registrar {
+   public:
+    explicit Registrar(Handlers& handlers) : handlers_(handlers) {}
+
+    template <typename Message>
+    typename std::enable_if<std::is_same<Sender, typename Message::Sender>::value &&
+                            std::is_same<Receiver, typename Message::Receiver>::value>::type
+    operator()(Message*) const {
+      auto index(DispatchIndex(Message::kAction, Message::SourcePersona::value,
+                               Message::DestinationPersona::value));
+      assert(index < handlers_.size());
+      if (!handlers_[index])
+        handlers_[index] = &DispatchTable::Handle<Message>;
+    }
+
+    template <typename Message>
+    typename std::enable_if<!std::is_same<Sender, typename Message::Sender>::value ||
+                            !std::is_same<Receiver, typename Message::Receiver>::value>::type
+    operator()(Message*) const {}
+
+   private:
+    Handlers& handlers_;
+  };
+
   template <typename Message>
-  typename std::enable_if<std::is_same<Sender, typename Message::Sender>::value &&
-                              std::is_same<Receiver, typename Message::Receiver>::value,
-                          typename PersonaService::HandleMessageReturnType>::type
-  operator()(const Message& message) const {
-//     LOG(kVerbose) << "PersonaDemuxer calling persona_service HandleMessage";
+  static ReturnType Handle(PersonaService& persona_service, const TypeErasedMessageWrapper& message,
+                           const Sender& sender, const Receiver& receiver) {
     // If you have a compiler error leading here, you probably haven't implemented HandleMessage for
     // *every* type of message in the PublicMessages and VaultMessages variants of PersonaService.
-    return persona_service_.HandleMessage(message, sender_, receiver_);
-  }
-  template <typename Message>
-  typename std::enable_if<!std::is_same<Sender, typename Message::Sender>::value ||
-                              !std::is_same<Receiver, typename Message::Receiver>::value,
-                          typename PersonaService::HandleMessageReturnType>::type
-  operator()(const Message& /*message*/) const {
-    LOG(kError) << "invalid function call because of un-specialised templated method";
-    // Should never come here.  Ideally this specialisation shouldn't exist, but the static visitor
-    // requires all types in the variant to be handled.
-    BOOST_THROW_EXCEPTION(MakeError(CommonErrors::invalid_parameter));
+    return persona_service.HandleMessage(Message(message), sender, receiver);
   }
 
- private:
-  PersonaService& persona_service_;
-  const Sender& sender_;
-  const Receiver& receiver_;
+  Handlers handlers_;
 };
 
+template <typename PersonaService, typename Sender, typename Receiver>
+const DispatchTable<PersonaService, Sender, Receiver>
+    DispatchTable<PersonaService, Sender, Receiver>::kInstance;
+
 }  // namespace detail
 
 template <typename PersonaService>
@@ -97,12 +172,14 @@ class Service {
   ReturnType HandleMessage(
       const nfs::TypeErasedMessageWrapper& message, const Sender& sender,
       const Receiver& receiver) {
-    const detail::PersonaDemuxer<PersonaService, Sender, Receiver> demuxer(*impl_, sender,
-                                                                           receiver);
-    static std::is_void<PublicMessages> public_messages_void_state;
-    static std::is_void<VaultMessages> vault_messages_void_state;
+    auto handler(detail::DispatchTable<PersonaService, Sender, Receiver>::kInstance.Find(message));
+    if (!handler) {
+      LOG(kError) << "Invalid request. No handler for " << std::get<0>(message) << " from "
+                  << std::get<1>(message).data << " to " << std::get<2>(message).data;
+      BOOST_THROW_EXCEPTION(MakeError(CommonErrors::invalid_parameter));
+    }
     try {
-      return HandleMessage(message, demuxer, public_messages_void_state, vault_messages_void_state);
+      return handler(*impl_, message, sender, receiver);
     }
     catch (const maidsafe_error& error) {
       LOG(kError) << "Invalid request. " << boost::diagnostic_information(error);
@@ -136,68 +213,6 @@ class Service {
   }
 
  private:
-  typedef std::true_type IsVoid;
-  typedef std::false_type IsNotVoid;
-
-  template <typename Demuxer>
-  ReturnType HandlePublicMessage(const nfs::TypeErasedMessageWrapper& message,
-                                 const Demuxer& demuxer) {
-//     LOG(kVerbose) << "nfs HandlePublicMessage";
-    PublicMessages public_variant_message;
-    if (!nfs::GetVariant(message, public_variant_message)) {
-//       LOG(kError) << "Not a valid public message";
-      BOOST_THROW_EXCEPTION(MakeError(CommonErrors::invalid_parameter));
-    }
-    return boost::apply_visitor(demuxer, public_variant_message);
-  }
-  template <typename Demuxer>
-  ReturnType HandleVaultMessage(const nfs::TypeErasedMessageWrapper& message,
-                                const Demuxer& demuxer) {
-//     LOG(kVerbose) << "nfs HandleVaultMessage";
-    VaultMessages vault_variant_message;
-    if (!vault::GetVariant(message, vault_variant_message)) {
-      LOG(kError) << "Not a valid vault message" << vault_variant_message;
-      BOOST_THROW_EXCEPTION(MakeError(CommonErrors::invalid_parameter));
-    } else {
-      LOG(kVerbose) << "processing: " << vault_variant_message;
-    }
-    return boost::apply_visitor(demuxer, vault_variant_message);
-  }
-
-  // Public messages only are non-void.
-  template <typename Demuxer>
-  ReturnType HandleMessage(const nfs::TypeErasedMessageWrapper& message, const Demuxer& demuxer,
-                           IsNotVoid, IsVoid) {
-    return HandlePublicMessage(message, demuxer);
-  }
-
-  // Vault messages only are non-void.
-  template <typename Demuxer>
-  ReturnType HandleMessage(const nfs::TypeErasedMessageWrapper& message, const Demuxer& demuxer,
-                           IsVoid, IsNotVoid) {
-    return HandleVaultMessage(message, demuxer);
-  }
-
-  // Both types of message are non-void.
-  template <typename Demuxer>
-  ReturnType HandleMessage(const nfs::TypeErasedMessageWrapper& message, const Demuxer& demuxer,
-                           IsNotVoid, IsNotVoid) {
-    try {
-      return HandlePublicMessage(message, demuxer);
-    }
-    catch (const maidsafe_error& error) {
-      if (error.code() != make_error_code((CommonErrors::invalid_parameter)))
-        throw;
-    }
-    try {
-      return HandleVaultMessage(message, demuxer);
-    }
-    catch (const maidsafe_error& error) {
-     if (error.code() != make_error_code((CommonErrors::invalid_parameter)))
-       throw;
-    }
-  }
-
   std::unique_ptr<PersonaService> impl_;
 };
 
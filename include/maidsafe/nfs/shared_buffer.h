@@ -0,0 +1,63 @@
+/*  Copyright 2013 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#ifndef MAIDSAFE_NFS_SHARED_BUFFER_H_
+#define MAIDSAFE_NFS_SHARED_BUFFER_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "maidsafe/common/config.h"
+#include "maidsafe/common/types.h"
+
+namespace maidsafe {
+
+namespace nfs {
+
+// Immutable, reference-counted byte buffer used for chunk payloads.  Copies share the same bytes,
+// so a payload can be passed from the wire through the message types, handlers and timers to the
+// caller without being deep-copied at each step.
+class SharedBuffer {
+ public:
+  SharedBuffer();
+  explicit SharedBuffer(std::string data);
+  explicit SharedBuffer(const NonEmptyString& data);
+  SharedBuffer(const SharedBuffer& other);
+  SharedBuffer(SharedBuffer&& other) MAIDSAFE_NOEXCEPT;
+  SharedBuffer& operator=(SharedBuffer other);
+
+  // Throws CommonErrors::uninitialised if the buffer has not been initialised.
+  const std::string& string() const;
+  bool IsInitialised() const;
+  size_t size() const;
+
+  friend void swap(SharedBuffer& lhs, SharedBuffer& rhs) MAIDSAFE_NOEXCEPT;
+
+ private:
+  std::shared_ptr<const std::string> data_;
+};
+
+bool operator==(const SharedBuffer& lhs, const SharedBuffer& rhs);
+bool operator!=(const SharedBuffer& lhs, const SharedBuffer& rhs);
+
+}  // namespace nfs
+
+}  // namespace maidsafe
+
+#endif  // MAIDSAFE_NFS_SHARED_BUFFER_H_
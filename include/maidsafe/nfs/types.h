@@ -63,6 +63,9 @@ DEFINE_OSTREAMABLE_ENUM_VALUES(MessageAction, int32_t,
     (CreateVersionTreeRequest)
     (CreateVersionTreeResponse)
     (UpdateAccount)
+    (PutBatchRequest)
+    (PutBatchResponse)
+    (GetVersionsSinceRequest)
     (NoOperation))  // NoOperation is added to avoid re-definition of types error in
                     // vault::message_types.
 // Defines:
@@ -103,6 +106,8 @@ struct PersonaTypes;
 namespace detail {
 struct MessageIdTag;
 }
+// 32 bits wide, since that is how peers parse it from the wire.  Ids aren't guaranteed to be
+// unique across processes (see detail::GetNewMessageId).
 typedef TaggedValue<int32_t, detail::MessageIdTag> MessageId;
 
 }  // namespace nfs
@@ -19,8 +19,8 @@
 #ifndef MAIDSAFE_NFS_UTILS_H_
 #define MAIDSAFE_NFS_UTILS_H_
 
+#include <algorithm>
 #include <functional>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -28,6 +28,8 @@
 #include <system_error>
 #include <vector>
 
+#include "boost/optional/optional.hpp"
+
 #include "maidsafe/common/error.h"
 #include "maidsafe/common/utils.h"
 #include "maidsafe/routing/parameters.h"
@@ -88,23 +90,22 @@ std::error_code ErrorCode(const MessageContents& response) {
   return response.return_code.value.code();
 }
 
-// If 'responses' contains >= n successsful responses where n is 'successes_required', returns
-// <iterator to nth successful reply, true> otherwise
-// <iterator to most frequent failed reply, false>.  If there is more than one most frequent type,
-// (e.g. 2 'no_such_element' and 2 'invalid_parameter') the iterator points to the first which
-// reaches the frequency.
-template <typename MessageContents>
-std::pair<typename std::vector<MessageContents>::const_iterator, bool>
-    GetSuccessOrMostFrequentResponse(const std::vector<MessageContents>& responses,
-                                     int successes_required);
-
+// Tallies the responses to an operation as they arrive.  The operation succeeds once
+// 'successes_required' successful responses have been received, and the callback is then invoked
+// with the last of these.  Otherwise it fails once more than half of the group has responded, and
+// the callback is invoked with the most frequent failure (if there is more than one most frequent
+// type, e.g. 2 'no_such_element' and 2 'invalid_parameter', the first to reach that frequency).
+// Only that failure is retained; other responses are discarded once counted.
 template <typename MessageContents>
 class OpData {
  public:
   OpData(int successes_required, std::function<void(MessageContents)> callback);
-  void HandleResponseContents(MessageContents&& response_contents);
+  // Returns true once the operation has completed, i.e. no further responses are needed.
+  bool HandleResponseContents(MessageContents&& response_contents);
 
  private:
+  typedef std::pair<std::error_code, int> ErrorCount;
+
   OpData(const OpData&);
   OpData(OpData&&);
   OpData& operator=(OpData);
@@ -112,82 +113,76 @@ class OpData {
   mutable std::mutex mutex_;
   int successes_required_;
   std::function<void(MessageContents)> callback_;
-  std::vector<MessageContents> responses_;
+  int response_count_, success_count_, most_frequent_error_count_;
+  // One entry per distinct error code received.  Reserved for the maximum number of responses
+  // tallied, so it never reallocates.
+  std::vector<ErrorCount> error_counts_;
+  boost::optional<MessageContents> most_frequent_error_;
   bool callback_executed_;
 };
 
 // ==================== Implementation =============================================================
-template <typename MessageContents>
-std::pair<typename std::vector<MessageContents>::const_iterator, bool>
-GetSuccessOrMostFrequentResponse(const std::vector<MessageContents>& responses,
-                                 int successes_required) {
-  LOG(kVerbose) << "GetSuccessOrMostFrequentResponse responses.size() : "
-                << responses.size() << " successes_required : " << successes_required;
-  auto most_frequent_itr(std::end(responses));
-  int successes(0), most_frequent(0);
-  typedef std::map<std::error_code, int> Count;
-  Count count;
-  for (auto itr(std::begin(responses)); itr != std::end(responses); ++itr) {
-    int this_reply_count(++count[ErrorCode(*itr)]);
-    LOG(kVerbose) << "GetSuccessOrMostFrequentResponse this_reply_count : " << this_reply_count;
-    if (IsSuccess(*itr)) {
-      LOG(kVerbose) << "GetSuccessOrMostFrequentResponse successes : " << successes;
-      if (++successes >= successes_required) {
-        LOG(kVerbose) << "GetSuccessOrMostFrequentResponse return succeeded";
-        return std::make_pair(itr, true);
-      }
-    } else {
-      LOG(kVerbose) << "GetSuccessOrMostFrequentResponse failed";
-      if (this_reply_count > most_frequent) {
-        most_frequent = this_reply_count;
-        most_frequent_itr = itr;
-      }
-    }
-  }
-  return std::make_pair(most_frequent_itr, false);
-}
-
 template <typename MessageContents>
 OpData<MessageContents>::OpData(int successes_required,
                                 std::function<void(MessageContents)> callback)
     : mutex_(),
       successes_required_(successes_required),
-      callback_(callback),
-      responses_(),
-      callback_executed_(!callback) {
-  if (!callback || successes_required <= 0) {
+      callback_(std::move(callback)),
+      response_count_(0),
+      success_count_(0),
+      most_frequent_error_count_(0),
+      error_counts_(),
+      most_frequent_error_(),
+      callback_executed_(!callback_) {
+  if (!callback_ || successes_required <= 0) {
     LOG(kError) << "invalid parameters for OpData constructor";
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::invalid_parameter));
   }
+  error_counts_.reserve(routing::Parameters::group_size / 2U + 1);
 }
 
 template <typename MessageContents>
-void OpData<MessageContents>::HandleResponseContents(MessageContents&& response_contents) {
-  LOG(kVerbose) << "OpData<MessageContents>::HandleResponseContents";
+bool OpData<MessageContents>::HandleResponseContents(MessageContents&& response_contents) {
   std::function<void(MessageContents)> callback;
-  std::unique_ptr<MessageContents> result_ptr;
   {
     std::lock_guard<std::mutex> lock(mutex_);
     if (callback_executed_) {
       LOG(kInfo) << "OpData<MessageContents>::HandleResponseContents already called back";
-      return;
+      return true;
     }
-    responses_.push_back(std::move(response_contents));
-    auto result(GetSuccessOrMostFrequentResponse(responses_, successes_required_));
-    // TODO(Fraser#5#): 2013-08-18 - Confirm expected count
-    if (result.second || responses_.size() > (routing::Parameters::group_size / 2U)) {
-      // Operation has succeeded or failed overall
-      callback = callback_;
-      callback_executed_ = true;
-      result_ptr = std::unique_ptr<MessageContents>(new MessageContents(*result.first));
+    ++response_count_;
+    bool succeeded(false);
+    if (IsSuccess(response_contents)) {
+      succeeded = (++success_count_ >= successes_required_);
     } else {
-      LOG(kWarning) << "OpData<MessageContents>::HandleResponseContents"
-                    << " incorrect result or not enough result";
-      return;
+      auto error_code(ErrorCode(response_contents));
+      auto itr(std::find_if(std::begin(error_counts_), std::end(error_counts_),
+                            [&](const ErrorCount& entry) { return entry.first == error_code; }));
+      if (itr == std::end(error_counts_))
+        itr = error_counts_.insert(itr, std::make_pair(error_code, 0));
+      if (++itr->second > most_frequent_error_count_) {
+        most_frequent_error_count_ = itr->second;
+        most_frequent_error_ = std::move(response_contents);
+      }
+    }
+    // TODO(Fraser#5#): 2013-08-18 - Confirm expected count
+    if (!succeeded &&
+        static_cast<unsigned>(response_count_) <= routing::Parameters::group_size / 2U) {
+      LOG(kVerbose) << "OpData<MessageContents>::HandleResponseContents not enough results yet";
+      return false;
     }
+    // Operation has succeeded or failed overall.  No further responses are accepted, so the
+    // result and the callback can be moved out rather than copied.
+    callback = std::move(callback_);
+    callback_executed_ = true;
+    // If every response was a success but there weren't enough of them, the last is reported.
+    if (!succeeded && most_frequent_error_)
+      response_contents = std::move(*most_frequent_error_);
+    most_frequent_error_ = boost::none;
   }
   LOG(kInfo) << "OpData<MessageContents>::HandleResponseContents call back";
-  callback(*result_ptr);
+  callback(std::move(response_contents));
+  return true;
 }
 
 }  // namespace nfs
@@ -29,6 +29,7 @@
 #include "maidsafe/common/data_types/data_type_values.h"
 #include "maidsafe/common/data_types/structured_data_versions.h"
 
+#include "maidsafe/nfs/shared_buffer.h"
 #include "maidsafe/nfs/vault/account_creation.h"
 #include "maidsafe/nfs/vault/account_removal.h"
 #include "maidsafe/nfs/vault/pmid_registration.h"
@@ -53,7 +54,7 @@ bool operator==(const Empty& /*lhs*/, const Empty& /*rhs*/);
 struct AvailableSize {
   explicit AvailableSize(uint64_t size);
   AvailableSize(const AvailableSize& other);
-  AvailableSize(AvailableSize&& other);
+  AvailableSize(AvailableSize&& other) MAIDSAFE_NOEXCEPT;
   AvailableSize& operator=(AvailableSize other);
 
   explicit AvailableSize(const std::string& serialised_copy);
@@ -70,7 +71,7 @@ void swap(AvailableSize& lhs, AvailableSize& rhs) MAIDSAFE_NOEXCEPT;
 struct DiffSize {
   explicit DiffSize(int64_t size);
   DiffSize(const DiffSize& other);
-  DiffSize(DiffSize&& other);
+  DiffSize(DiffSize&& other) MAIDSAFE_NOEXCEPT;
   DiffSize& operator=(DiffSize other);
 
   explicit DiffSize(const std::string& serialised_copy);
@@ -93,7 +94,7 @@ struct DataName {
 
   DataName();
   DataName(const DataName& other);
-  DataName(DataName&& other);
+  DataName(DataName&& other) MAIDSAFE_NOEXCEPT;
   DataName& operator=(DataName other);
 
   explicit DataName(const std::string& serialised_copy);
@@ -120,7 +121,7 @@ struct DataNames {
   explicit DataNames(const std::vector<DataName>& data_names);
   DataNames();
   DataNames(const DataNames& other);
-  DataNames(DataNames&& other);
+  DataNames(DataNames&& other) MAIDSAFE_NOEXCEPT;
   DataNames& operator=(DataNames other);
 
   explicit DataNames(const std::string& serialised_copy);
@@ -145,7 +146,7 @@ struct DataNameAndVersion {
   DataNameAndVersion(const DataName& data_name_in,
                      const StructuredDataVersions::VersionName& version_name_in);
   DataNameAndVersion(const DataNameAndVersion& other);
-  DataNameAndVersion(DataNameAndVersion&& other);
+  DataNameAndVersion(DataNameAndVersion&& other) MAIDSAFE_NOEXCEPT;
   DataNameAndVersion& operator=(DataNameAndVersion other);
 
   explicit DataNameAndVersion(const std::string& serialised_copy);
@@ -158,6 +159,37 @@ struct DataNameAndVersion {
 bool operator==(const DataNameAndVersion& lhs, const DataNameAndVersion& rhs);
 void swap(DataNameAndVersion& lhs, DataNameAndVersion& rhs) MAIDSAFE_NOEXCEPT;
 
+// ========================== DataNameVersionAndLimit ==============================================
+
+// Requests at most 'limit' versions (0 meaning no limit) starting at 'version_name'.  Serialises
+// identically to DataNameAndVersion when 'limit' is 0.
+struct DataNameVersionAndLimit {
+  DataNameVersionAndLimit();
+
+  template <typename DataNameType>
+  DataNameVersionAndLimit(const DataNameType& data_name_in,
+                          const StructuredDataVersions::VersionName& version_name_in,
+                          uint32_t limit_in)
+      : data_name(data_name_in), version_name(version_name_in), limit(limit_in) {}
+
+  DataNameVersionAndLimit(const DataName& data_name_in,
+                          const StructuredDataVersions::VersionName& version_name_in,
+                          uint32_t limit_in);
+  DataNameVersionAndLimit(const DataNameVersionAndLimit& other);
+  DataNameVersionAndLimit(DataNameVersionAndLimit&& other) MAIDSAFE_NOEXCEPT;
+  DataNameVersionAndLimit& operator=(DataNameVersionAndLimit other);
+
+  explicit DataNameVersionAndLimit(const std::string& serialised_copy);
+  std::string Serialise() const;
+
+  DataName data_name;
+  StructuredDataVersions::VersionName version_name;
+  uint32_t limit;
+};
+
+bool operator==(const DataNameVersionAndLimit& lhs, const DataNameVersionAndLimit& rhs);
+void swap(DataNameVersionAndLimit& lhs, DataNameVersionAndLimit& rhs) MAIDSAFE_NOEXCEPT;
+
 // ========================== DataNameOldNewVersion ================================================
 
 struct DataNameOldNewVersion {
@@ -173,7 +205,7 @@ struct DataNameOldNewVersion {
                         const StructuredDataVersions::VersionName& old_version,
                         const StructuredDataVersions::VersionName& new_version);
   DataNameOldNewVersion(const DataNameOldNewVersion& other);
-  DataNameOldNewVersion(DataNameOldNewVersion&& other);
+  DataNameOldNewVersion(DataNameOldNewVersion&& other) MAIDSAFE_NOEXCEPT;
   DataNameOldNewVersion& operator=(DataNameOldNewVersion other);
 
   explicit DataNameOldNewVersion(const std::string& serialised_copy);
@@ -198,7 +230,7 @@ struct VersionTreeCreation {
   VersionTreeCreation(const DataName& name, const StructuredDataVersions::VersionName& version,
                       uint32_t max_versions_in, uint32_t max_branches_in);
   VersionTreeCreation(const VersionTreeCreation& other);
-  VersionTreeCreation(VersionTreeCreation&& other);
+  VersionTreeCreation(VersionTreeCreation&& other) MAIDSAFE_NOEXCEPT;
   VersionTreeCreation& operator=(VersionTreeCreation other);
 
   explicit VersionTreeCreation(const std::string& serialised_copy);
@@ -220,33 +252,53 @@ struct DataNameAndContent {
       : name(data.name()), content(data.Serialise().data) {}
 
   DataNameAndContent(DataTagValue type_in, const Identity& name_in, NonEmptyString content_in);
+  DataNameAndContent(DataName name_in, nfs::SharedBuffer content_in);
 
   DataNameAndContent();
   DataNameAndContent(const DataNameAndContent& other);
-  DataNameAndContent(DataNameAndContent&& other);
+  DataNameAndContent(DataNameAndContent&& other) MAIDSAFE_NOEXCEPT;
   DataNameAndContent& operator=(DataNameAndContent other);
 
   explicit DataNameAndContent(const std::string& serialised_copy);
   std::string Serialise() const;
 
   DataName name;
-  NonEmptyString content;
+  nfs::SharedBuffer content;
 };
 
 bool operator==(const DataNameAndContent& lhs, const DataNameAndContent& rhs);
 void swap(DataNameAndContent& lhs, DataNameAndContent& rhs) MAIDSAFE_NOEXCEPT;
 
+// ========================== DataNamesAndContents =================================================
+
+struct DataNamesAndContents {
+  DataNamesAndContents();
+  explicit DataNamesAndContents(std::vector<DataNameAndContent> data_in);
+  DataNamesAndContents(const DataNamesAndContents& other);
+  DataNamesAndContents(DataNamesAndContents&& other) MAIDSAFE_NOEXCEPT;
+  DataNamesAndContents& operator=(DataNamesAndContents other);
+
+  explicit DataNamesAndContents(const std::string& serialised_copy);
+  std::string Serialise() const;
+
+  std::vector<DataNameAndContent> data;
+};
+
+bool operator==(const DataNamesAndContents& lhs, const DataNamesAndContents& rhs);
+void swap(DataNamesAndContents& lhs, DataNamesAndContents& rhs) MAIDSAFE_NOEXCEPT;
+
 // ========================== Content ==============================================================
 
 struct Content {
   explicit Content(const std::string& data);
+  explicit Content(nfs::SharedBuffer data);
   Content();
   Content(const Content& other);
-  Content(Content&& other);
+  Content(Content&& other) MAIDSAFE_NOEXCEPT;
   Content& operator=(Content other);
   std::string Serialise() const;
 
-  std::string data;
+  nfs::SharedBuffer data;
 };
 
 bool operator==(const Content& lhs, const Content& rhs);
@@ -264,7 +316,7 @@ struct DataNameAndRandomString {
 
   DataNameAndRandomString();
   DataNameAndRandomString(const DataNameAndRandomString& other);
-  DataNameAndRandomString(DataNameAndRandomString&& other);
+  DataNameAndRandomString(DataNameAndRandomString&& other) MAIDSAFE_NOEXCEPT;
   DataNameAndRandomString& operator=(DataNameAndRandomString other);
 
   explicit DataNameAndRandomString(const std::string& serialised_copy);
@@ -287,7 +339,7 @@ struct DataNameAndCost {
 
   DataNameAndCost();
   DataNameAndCost(const DataNameAndCost& other);
-  DataNameAndCost(DataNameAndCost&& other);
+  DataNameAndCost(DataNameAndCost&& other) MAIDSAFE_NOEXCEPT;
   DataNameAndCost& operator=(DataNameAndCost other);
 
   explicit DataNameAndCost(const std::string& serialised_copy);
@@ -309,7 +361,7 @@ struct DataNameAndSize {
   DataNameAndSize(DataTagValue type_in, const Identity& name_in, int32_t size_in);
   DataNameAndSize();
   DataNameAndSize(const DataNameAndSize& other);
-  DataNameAndSize(DataNameAndSize&& other);
+  DataNameAndSize(DataNameAndSize&& other) MAIDSAFE_NOEXCEPT;
   DataNameAndSize& operator=(DataNameAndSize other);
 
   explicit DataNameAndSize(const std::string& serialised_copy);
@@ -341,7 +393,7 @@ struct DataNameAndContentOrCheckResult {
                                   const CheckResult& check_result_in);
   DataNameAndContentOrCheckResult();
   DataNameAndContentOrCheckResult(const DataNameAndContentOrCheckResult& other);
-  DataNameAndContentOrCheckResult(DataNameAndContentOrCheckResult&& other);
+  DataNameAndContentOrCheckResult(DataNameAndContentOrCheckResult&& other) MAIDSAFE_NOEXCEPT;
   DataNameAndContentOrCheckResult& operator=(DataNameAndContentOrCheckResult other);
 
   explicit DataNameAndContentOrCheckResult(const std::string& serialised_copy);
@@ -363,7 +415,7 @@ struct PmidHealth {
   PmidHealth();
   explicit PmidHealth(const std::string& serialised_copy);
   PmidHealth(const PmidHealth& other);
-  PmidHealth(PmidHealth&& other);
+  PmidHealth(PmidHealth&& other) MAIDSAFE_NOEXCEPT;
   PmidHealth& operator=(PmidHealth other);
 
   std::string Serialise() const;
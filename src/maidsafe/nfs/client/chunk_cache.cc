@@ -0,0 +1,184 @@
+/*  Copyright 2013 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#include "maidsafe/nfs/client/chunk_cache.h"
+
+#include "boost/exception/diagnostic_information.hpp"
+#include "boost/filesystem/operations.hpp"
+
+#include "maidsafe/common/error.h"
+#include "maidsafe/common/log.h"
+#include "maidsafe/common/utils.h"
+
+namespace fs = boost::filesystem;
+
+namespace maidsafe {
+
+namespace nfs_client {
+
+ChunkCache::ChunkCache(MemoryUsage max_memory_usage)
+    : kMaxMemoryUsage_(max_memory_usage.data),
+      kMaxDiskUsage_(0),
+      kDiskPath_(),
+      memory_usage_(0),
+      disk_usage_(0),
+      memory_lru_(),
+      disk_lru_(),
+      memory_entries_(),
+      disk_entries_(),
+      mutex_() {}
+
+ChunkCache::ChunkCache(MemoryUsage max_memory_usage, const fs::path& disk_path,
+                       DiskUsage max_disk_usage)
+    : kMaxMemoryUsage_(max_memory_usage.data),
+      kMaxDiskUsage_(max_disk_usage.data),
+      kDiskPath_(disk_path),
+      memory_usage_(0),
+      disk_usage_(0),
+      memory_lru_(),
+      disk_lru_(),
+      memory_entries_(),
+      disk_entries_(),
+      mutex_() {
+  boost::system::error_code error_code;
+  if (!fs::exists(kDiskPath_, error_code) && !fs::create_directories(kDiskPath_, error_code)) {
+    LOG(kError) << "Can't create chunk cache directory " << kDiskPath_ << ": "
+                << error_code.message();
+    BOOST_THROW_EXCEPTION(MakeError(CommonErrors::filesystem_io_error));
+  }
+}
+
+ChunkCache::~ChunkCache() {
+  boost::system::error_code error_code;
+  for (const auto& key : disk_lru_)
+    fs::remove(FilePath(key), error_code);
+}
+
+boost::optional<ImmutableData> ChunkCache::Get(const ImmutableData::Name& name) {
+  const std::string& key(name.value.string());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto in_memory(memory_entries_.find(key));
+    if (in_memory != std::end(memory_entries_)) {
+      memory_lru_.splice(std::begin(memory_lru_), memory_lru_, in_memory->second.lru_position);
+      return in_memory->second.data;
+    }
+    if (disk_entries_.find(key) == std::end(disk_entries_))
+      return boost::none;
+  }
+
+  // The file may be removed while it's being read, in which case the read or validation fails and
+  // the chunk is treated as not cached.
+  boost::optional<ImmutableData> data;
+  try {
+    data = ImmutableData(name, ImmutableData::serialised_type(ReadFile(FilePath(key))));
+  }
+  catch (const std::exception& e) {
+    LOG(kWarning) << "Dropping unreadable cached chunk " << HexSubstr(key) << ": "
+                  << boost::diagnostic_information(e);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  RemoveFromDisk(key);
+  if (data && memory_entries_.find(key) == std::end(memory_entries_))
+    StoreInMemory(key, *data);
+  return data;
+}
+
+void ChunkCache::Store(const ImmutableData& data) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const std::string& key(data.name().value.string());
+  auto in_memory(memory_entries_.find(key));
+  if (in_memory != std::end(memory_entries_)) {
+    memory_lru_.splice(std::begin(memory_lru_), memory_lru_, in_memory->second.lru_position);
+    return;
+  }
+  if (disk_entries_.find(key) != std::end(disk_entries_))
+    return;
+  StoreInMemory(key, data);
+}
+
+void ChunkCache::StoreInMemory(const std::string& key, ImmutableData data) {
+  uint64_t size(data.data().string().size());
+  if (size > kMaxMemoryUsage_) {
+    StoreOnDisk(key, data.data());
+    return;
+  }
+
+  memory_lru_.push_front(key);
+  MemoryEntry entry = { std::move(data), std::begin(memory_lru_) };
+  memory_entries_.insert(std::make_pair(key, std::move(entry)));
+  memory_usage_ += size;
+  while (memory_usage_ > kMaxMemoryUsage_) {
+    auto evicted(memory_entries_.find(memory_lru_.back()));
+    memory_usage_ -= evicted->second.data.data().string().size();
+    StoreOnDisk(evicted->first, evicted->second.data.data());
+    memory_entries_.erase(evicted);
+    memory_lru_.pop_back();
+  }
+}
+
+void ChunkCache::StoreOnDisk(const std::string& key, const NonEmptyString& content) {
+  uint64_t size(content.string().size());
+  if (kDiskPath_.empty() || size > kMaxDiskUsage_)
+    return;
+
+  while (disk_usage_ + size > kMaxDiskUsage_)
+    RemoveFromDisk(disk_lru_.back());
+  if (!WriteFile(FilePath(key), content.string())) {
+    LOG(kWarning) << "Failed to write cached chunk " << HexSubstr(key);
+    return;
+  }
+  disk_lru_.push_front(key);
+  DiskEntry entry = { size, std::begin(disk_lru_) };
+  disk_entries_.insert(std::make_pair(key, entry));
+  disk_usage_ += size;
+}
+
+void ChunkCache::RemoveFromDisk(const std::string& key) {
+  auto found(disk_entries_.find(key));
+  if (found == std::end(disk_entries_))
+    return;
+  boost::system::error_code error_code;
+  fs::remove(FilePath(key), error_code);
+  disk_usage_ -= found->second.size;
+  disk_lru_.erase(found->second.lru_position);
+  disk_entries_.erase(found);
+}
+
+fs::path ChunkCache::FilePath(const std::string& key) const {
+  return kDiskPath_ / HexEncode(key);
+}
+
+bool GetFromChunkCache(ChunkCache& chunk_cache, const ImmutableData::Name& data_name,
+                       boost::promise<ImmutableData>& promise) {
+  auto data(chunk_cache.Get(data_name));
+  if (!data)
+    return false;
+  LOG(kVerbose) << "Got chunk " << HexSubstr(data_name.value) << " from chunk cache";
+  promise.set_value(*data);
+  return true;
+}
+
+void AddToChunkCache(ChunkCache& chunk_cache, const ImmutableData& data) {
+  chunk_cache.Store(data);
+}
+
+}  // namespace nfs_client
+
+}  // namespace maidsafe
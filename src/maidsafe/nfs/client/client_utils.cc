@@ -18,17 +18,19 @@
 
 #include "maidsafe/nfs/client/client_utils.h"
 
+#include <utility>
+
 namespace maidsafe {
 
 namespace nfs_client {
 
 void HandleGetVersionsOrBranchResult(
-    const StructuredDataNameAndContentOrReturnCode& result,
+    StructuredDataNameAndContentOrReturnCode result,
     std::shared_ptr<boost::promise<std::vector<StructuredDataVersions::VersionName>>> promise) {
   LOG(kVerbose) << "nfs_client::HandleGetVersionsOrBranchResult";
   try {
     if (result.structured_data) {
-      promise->set_value(result.structured_data->versions);
+      promise->set_value(std::move(result.structured_data->mutable_versions()));
     } else if (result.data_name_and_return_code) {
       LOG(kInfo) << "nfs_client::HandleGetVersionsOrBranchResult"
                  << " error during get version or branch";
@@ -46,6 +48,32 @@ void HandleGetVersionsOrBranchResult(
   }
 }
 
+void HandleGetBranchPageResult(StructuredDataNameAndContentOrReturnCode result, uint32_t limit,
+                               std::shared_ptr<boost::promise<BranchPage>> promise) {
+  LOG(kVerbose) << "nfs_client::HandleGetBranchPageResult";
+  try {
+    if (result.structured_data) {
+      BranchPage page;
+      page.versions = std::move(result.structured_data->mutable_versions());
+      if (page.versions.size() > limit) {
+        page.next_page_start = page.versions[limit];
+        page.versions.resize(limit);
+      }
+      promise->set_value(std::move(page));
+    } else if (result.data_name_and_return_code) {
+      LOG(kInfo) << "nfs_client::HandleGetBranchPageResult error during get branch";
+      boost::throw_exception(result.data_name_and_return_code->return_code.value);
+    } else {
+      LOG(kInfo) << "nfs_client::HandleGetBranchPageResult uninitialised during get branch";
+      BOOST_THROW_EXCEPTION(MakeError(CommonErrors::uninitialised));
+    }
+  }
+  catch (...) {
+    LOG(kError) << "nfs_client::HandleGetBranchPageResult exception during get branch";
+    promise->set_exception(boost::current_exception());
+  }
+}
+
 void HandleCreateAccountResult(const ReturnCode& result,
                                std::shared_ptr<boost::promise<void>> promise) {
   LOG(kVerbose) << "nfs_client::HandleCreateAccountResult";
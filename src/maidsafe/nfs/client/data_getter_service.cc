@@ -35,13 +35,12 @@ void DataGetterService::HandleMessage(const GetResponse& message,
                                       const GetResponse::Sender& /*sender*/,
                                       const GetResponse::Receiver& receiver) {
   LOG(kVerbose) << "DataGetterService::HandleMessage GetResponse with message id "
-                << message.id.data << " with DataNameAndContentOrReturnCode "
-                << HexSubstr(message.contents->Serialise());
+                << message.id.data;
   assert(receiver.data == routing_.kNodeId());
   static_cast<void>(receiver);
   static_cast<void>(routing_);
   try {
-    get_handler_.AddResponse(message.id.data, *message.contents);
+    get_handler_.AddResponse(message.id.data, message.contents);
   }
   catch (const maidsafe_error& error) {
     if (error.code() != make_error_code(CommonErrors::no_such_element))
@@ -54,14 +53,12 @@ void DataGetterService::HandleMessage(const GetResponse& message,
 void DataGetterService::HandleMessage(const GetCachedResponse& message,
                                       const GetCachedResponse::Sender& /*sender*/,
                                       const GetCachedResponse::Receiver& receiver) {
-  LOG(kVerbose) << "DataGetterService::GetCachedResponse GetResponse "
-                << HexSubstr(message.Serialise()) << " with content "
-                << HexSubstr(message.contents->Serialise());
+  LOG(kVerbose) << "DataGetterService::GetCachedResponse GetResponse " << message.id;
   assert(receiver.data == routing_.kNodeId());
   static_cast<void>(receiver);
   static_cast<void>(routing_);
   try {
-    get_handler_.AddResponse(message.id.data, *message.contents);
+    get_handler_.AddResponse(message.id.data, message.contents);
   }
   catch (const maidsafe_error& error) {
     if (error.code() != make_error_code(CommonErrors::no_such_element))
@@ -0,0 +1,103 @@
+/*  Copyright 2013 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#include "maidsafe/nfs/client/latency_estimator.h"
+
+#include <algorithm>
+
+namespace maidsafe {
+
+namespace nfs_client {
+
+const size_t LatencyEstimator::kSampleCount(128);
+const size_t LatencyEstimator::kMinAdaptiveTimeoutSamples(8);
+const LatencyEstimator::Duration LatencyEstimator::kMinAdaptiveTimeout(std::chrono::seconds(10));
+
+LatencyEstimator::LatencyEstimator()
+    : samples_(), next_sample_(0), sample_count_(0), timeout_count_(0), smoothed_rtt_(),
+      rtt_variation_(), mutex_() {
+  samples_.reserve(kSampleCount);
+}
+
+void LatencyEstimator::AddSample(Duration latency) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  timeout_count_ = 0;
+  if (sample_count_++ == 0) {
+    smoothed_rtt_ = latency;
+    rtt_variation_ = latency / 2;
+  } else {
+    auto deviation(smoothed_rtt_ > latency ? smoothed_rtt_ - latency : latency - smoothed_rtt_);
+    rtt_variation_ = (rtt_variation_ * 3 + deviation) / 4;
+    smoothed_rtt_ = (smoothed_rtt_ * 7 + latency) / 8;
+  }
+  if (samples_.size() < kSampleCount) {
+    samples_.push_back(latency);
+  } else {
+    samples_[next_sample_] = latency;
+    next_sample_ = (next_sample_ + 1) % kSampleCount;
+  }
+}
+
+void LatencyEstimator::AddTimeout() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++timeout_count_;
+}
+
+unsigned LatencyEstimator::TimeoutCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return timeout_count_;
+}
+
+boost::optional<LatencyEstimator::Duration> LatencyEstimator::Percentile(
+    double percentile, size_t minimum_samples) const {
+  std::vector<Duration> samples;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (samples_.empty() || samples_.size() < minimum_samples)
+      return boost::none;
+    samples = samples_;
+  }
+  percentile = std::min(std::max(percentile, 0.0), 1.0);
+  auto index(static_cast<size_t>(percentile * static_cast<double>(samples.size() - 1)));
+  std::nth_element(std::begin(samples), std::begin(samples) + index, std::end(samples));
+  return samples[index];
+}
+
+boost::optional<LatencyEstimator::Duration> LatencyEstimator::RetransmissionTimeout(
+    size_t minimum_samples) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (sample_count_ == 0 || sample_count_ < minimum_samples)
+    return boost::none;
+  return smoothed_rtt_ + rtt_variation_ * 4;
+}
+
+LatencyEstimator::Duration AdaptiveTimeout(const LatencyEstimator& estimator,
+                                           LatencyEstimator::Duration timeout) {
+  auto retransmission_timeout(
+      estimator.RetransmissionTimeout(LatencyEstimator::kMinAdaptiveTimeoutSamples));
+  if (!retransmission_timeout)
+    return timeout;
+  auto adaptive_timeout(std::max(*retransmission_timeout, LatencyEstimator::kMinAdaptiveTimeout));
+  for (auto count(estimator.TimeoutCount()); count != 0 && adaptive_timeout < timeout; --count)
+    adaptive_timeout *= 2;
+  return std::min(timeout, adaptive_timeout);
+}
+
+}  // namespace nfs_client
+
+}  // namespace maidsafe
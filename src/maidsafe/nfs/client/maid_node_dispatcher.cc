@@ -36,6 +36,17 @@ void MaidNodeDispatcher::Stop() {
   LOG(kWarning) << " MaidNodeDispatcher::Stop() !";
 }
 
+void MaidNodeDispatcher::SendPutBatchRequest(routing::TaskId task_id,
+                                             const nfs_vault::DataNamesAndContents& data) {
+  LOG(kVerbose) << "MaidNodeDispatcher::SendPutBatchRequest for " << data.data.size()
+                << " chunks";
+  typedef nfs::PutBatchRequestFromMaidNodeToMaidManager NfsMessage;
+  CheckSourcePersonaType<NfsMessage>();
+  typedef routing::Message<NfsMessage::Sender, NfsMessage::Receiver> RoutingMessage;
+  NfsMessage nfs_message(nfs::MessageId(task_id), data);
+  RoutingSend(RoutingMessage(nfs_message.Serialise(), kThisNodeAsSender_, kMaidManagerReceiver_));
+}
+
 void MaidNodeDispatcher::SendCreateAccountRequest(
     routing::TaskId task_id,
     const nfs_vault::AccountCreation& account_creation) {
@@ -18,6 +18,9 @@
 
 #include "maidsafe/nfs/client/maid_node_nfs.h"
 
+#include <map>
+#include <set>
+
 #include "maidsafe/common/on_scope_exit.h"
 #include "maidsafe/common/error.h"
 #include "maidsafe/common/log.h"
@@ -67,6 +70,8 @@ void UpdateRequestPublicKeyFunctor(routing::RequestPublicKeyFunctor& request_pub
 }  // anonymous namespace
 
 
+const size_t MaidNodeNfs::kMaxPutBatchContentSize(1024 * 1024);
+
 std::shared_ptr<MaidNodeNfs> MaidNodeNfs::MakeShared(const passport::Maid& maid) {
   std::shared_ptr<MaidNodeNfs> maid_node_ptr{ new MaidNodeNfs{ maid } };
   maid_node_ptr->Init();
@@ -136,7 +141,7 @@ MaidNodeNfs::MaidNodeNfs(const passport::Maid& maid)
             new MaidNodeService(routing::SingleId(routing_->kNodeId()), rpc_timers_, get_handler_));
         return std::move(service);
       }()),
-      get_handler_(rpc_timers_.get_timer, dispatcher_) {
+      get_handler_(asio_service_, rpc_timers_.get_timer, dispatcher_) {
 }
 
 void MaidNodeNfs::Stop() {
@@ -155,6 +160,14 @@ MaidNodeNfs::OnNetworkHealthChange& MaidNodeNfs::network_health_change_signal()
   return network_health_change_signal_;
 }
 
+void MaidNodeNfs::SetChunkCache(std::shared_ptr<ChunkCache> chunk_cache) {
+  get_handler_.SetChunkCache(std::move(chunk_cache));
+}
+
+void MaidNodeNfs::SetGetHedging(bool enabled) {
+  get_handler_.SetHedging(enabled);
+}
+
 void MaidNodeNfs::InitRouting(std::vector<passport::PublicPmid> public_pmids) {
   routing::Functors functors(InitialiseRoutingCallbacks());
   if (!public_pmids.empty()) {
@@ -233,15 +246,72 @@ boost::future<void> MaidNodeNfs::CreateAccount(
       routing::Parameters::group_size - 1, response_functor));
   auto task_id(rpc_timers_.create_account_timer.NewTaskId());
   rpc_timers_.create_account_timer.AddTask(
-      timeout, [op_data](ResponseContents create_account_response) {
-                 op_data->HandleResponseContents(std::move(create_account_response));
-               },
+      timeout,
+      [op_data, task_id, this](ResponseContents create_account_response) {
+        if (op_data->HandleResponseContents(std::move(create_account_response)))
+          rpc_timers_.create_account_timer.ReleaseTask(task_id);
+      },
       // TODO(Fraser#5#): 2013-08-18 - Confirm expected count
       routing::Parameters::group_size - 1, task_id);
   dispatcher_.SendCreateAccountRequest(task_id, account_creation);
   return promise->get_future();
 }
 
+void MaidNodeNfs::PutBatch(std::vector<nfs_vault::DataNameAndContent> batch, PutPromises promises,
+                           const std::chrono::steady_clock::duration& timeout) {
+  typedef MaidNodeService::PutBatchResponse::Contents ResponseContents;
+  typedef nfs::OpData<ReturnCode> PutOpData;
+  assert(batch.size() == promises.size());
+  // The group's results are tallied separately for each chunk.  A chunk which appears more than
+  // once in the batch is only sent once, and all of its promises share the one result.
+  std::map<TypedDataName, PutPromises> promises_by_name;
+  std::vector<nfs_vault::DataNameAndContent> unique_batch;
+  for (size_t i(0); i < batch.size(); ++i) {
+    auto& chunk_promises(promises_by_name[GetTypedDataName(batch[i].name)]);
+    if (chunk_promises.empty())
+      unique_batch.push_back(std::move(batch[i]));
+    chunk_promises.push_back(promises[i]);
+  }
+  auto op_datas(std::make_shared<std::map<TypedDataName, std::shared_ptr<PutOpData>>>());
+  for (const auto& entry : promises_by_name) {
+    auto chunk_promises(entry.second);
+    auto response_functor([chunk_promises](const ReturnCode& result) {
+                             for (const auto& promise : chunk_promises)
+                               HandlePutResponseResult(result, promise);
+                          });
+    op_datas->insert(std::make_pair(entry.first, std::make_shared<PutOpData>(
+        routing::Parameters::group_size - 1, response_functor)));
+  }
+  LOG(kVerbose) << "MaidNodeNfs PutBatch of " << unique_batch.size() << " chunks";
+  auto task_id(rpc_timers_.put_batch_timer.NewTaskId());
+  rpc_timers_.put_batch_timer.AddTask(
+      timeout,
+      [op_datas, task_id, this](ResponseContents put_batch_response) {
+        std::set<TypedDataName> answered;
+        size_t completed(0);
+        for (auto& result : put_batch_response.results) {
+          auto name(GetTypedDataName(result.name));
+          auto itr(op_datas->find(name));
+          if (itr != std::end(*op_datas) && answered.insert(name).second &&
+              itr->second->HandleResponseContents(std::move(result.return_code))) {
+            ++completed;
+          }
+        }
+        // A chunk missing from a response (e.g. on timeout) counts as a failure for that chunk.
+        for (const auto& op_data : *op_datas) {
+          if (answered.count(op_data.first) == 0 &&
+              op_data.second->HandleResponseContents(ReturnCode())) {
+            ++completed;
+          }
+        }
+        if (completed == op_datas->size())
+          rpc_timers_.put_batch_timer.ReleaseTask(task_id);
+      },
+      routing::Parameters::group_size - 1, task_id);
+  dispatcher_.SendPutBatchRequest(task_id,
+                                  nfs_vault::DataNamesAndContents(std::move(unique_batch)));
+}
+
 void MaidNodeNfs::RemoveAccount(const nfs_vault::AccountRemoval& account_removal) {
   dispatcher_.SendRemoveAccountRequest(account_removal);
 }
@@ -37,6 +37,7 @@ std::error_code NoSuchElement() {
 MaidNodeService::RpcTimers::RpcTimers(AsioService& asio_service_)
     : get_timer(asio_service_),
       put_timer(asio_service_),
+      put_batch_timer(asio_service_),
       get_versions_timer(asio_service_),
       get_branch_timer(asio_service_),
       create_account_timer(asio_service_),
@@ -46,6 +47,7 @@ MaidNodeService::RpcTimers::RpcTimers(AsioService& asio_service_)
 void MaidNodeService::RpcTimers::CancellAll() {
   get_timer.CancelAll();
   put_timer.CancelAll();
+  put_batch_timer.CancelAll();
   get_versions_timer.CancelAll();
   get_branch_timer.CancelAll();
   create_account_timer.CancelAll();
@@ -61,13 +63,11 @@ MaidNodeService::MaidNodeService(const routing::SingleId& receiver,
 void MaidNodeService::HandleMessage(const GetResponse& message,
                                     const GetResponse::Sender& /*sender*/,
                                     const GetResponse::Receiver& receiver) {
-  LOG(kVerbose) << "MaidNodeService::HandleMessage GetResponse "
-                << HexSubstr(message.Serialise()) << " with content "
-                << HexSubstr(message.contents->Serialise());
+  LOG(kVerbose) << "MaidNodeService::HandleMessage GetResponse " << message.id;
   assert(receiver == kReceiver_);
   static_cast<void>(receiver);
   try {
-    get_handler_.AddResponse(message.id.data, *message.contents);
+    get_handler_.AddResponse(message.id.data, message.contents);
   }
   catch (const maidsafe_error& error) {
     if (error.code() != NoSuchElement())
@@ -84,7 +84,24 @@ void MaidNodeService::HandleMessage(const PutResponse& message,
   assert(receiver == kReceiver_);
   static_cast<void>(receiver);
   try {
-    rpc_timers_.put_timer.AddResponse(message.id.data, *message.contents);
+    rpc_timers_.put_timer.AddResponse(message.id.data, message.contents);
+  }
+  catch (const maidsafe_error& error) {
+    if (error.code() != NoSuchElement())
+      throw;
+    else
+      LOG(kWarning) << "Timer does not expect:" << message.id.data;
+  }
+}
+
+void MaidNodeService::HandleMessage(const PutBatchResponse& message,
+                                    const PutBatchResponse::Sender& /*sender*/,
+                                    const PutBatchResponse::Receiver& receiver) {
+  LOG(kVerbose) << "MaidNodeService::HandleMessage PutBatchResponse " << message.id;
+  assert(receiver == kReceiver_);
+  static_cast<void>(receiver);
+  try {
+    rpc_timers_.put_batch_timer.AddResponse(message.id.data, message.contents);
   }
   catch (const maidsafe_error& error) {
     if (error.code() != NoSuchElement())
@@ -97,13 +114,11 @@ void MaidNodeService::HandleMessage(const PutResponse& message,
 void MaidNodeService::HandleMessage(const GetCachedResponse& message,
                                     const GetCachedResponse::Sender& /*sender*/,
                                     const GetCachedResponse::Receiver& receiver) {
-  LOG(kVerbose) << "MaidNodeService::HandleMessage GetCachedResponse "
-                << HexSubstr(message.Serialise()) << " with content "
-                << HexSubstr(message.contents->Serialise());
+  LOG(kVerbose) << "MaidNodeService::HandleMessage GetCachedResponse " << message.id;
   assert(receiver == kReceiver_);
   static_cast<void>(receiver);
   try {
-    get_handler_.AddResponse(message.id.data, *message.contents);
+    get_handler_.AddResponse(message.id.data, message.contents);
   }
   catch (const maidsafe_error& error) {
     if (error.code() != NoSuchElement())
@@ -127,7 +142,7 @@ void MaidNodeService::HandleMessage(const GetVersionsResponse& message,
   assert(receiver == kReceiver_);
   static_cast<void>(receiver);
   try {
-    rpc_timers_.get_versions_timer.AddResponse(message.id.data, *message.contents);
+    rpc_timers_.get_versions_timer.AddResponse(message.id.data, message.contents);
   }
   catch (const maidsafe_error& error) {
     if (error.code() != NoSuchElement())
@@ -142,7 +157,7 @@ void MaidNodeService::HandleMessage(const PutVersionResponse& message,
                                     const PutVersionResponse::Receiver& /*receiver*/) {
   LOG(kInfo) << "Get response for PutVersion";
   try {
-    rpc_timers_.put_version_timer.AddResponse(message.id.data, *message.contents);
+    rpc_timers_.put_version_timer.AddResponse(message.id.data, message.contents);
   }
   catch (const maidsafe_error& error) {
     if (error.code() != NoSuchElement())
@@ -158,7 +173,7 @@ void MaidNodeService::HandleMessage(const GetBranchResponse& message,
   assert(receiver == kReceiver_);
   static_cast<void>(receiver);
   try {
-    rpc_timers_.get_branch_timer.AddResponse(message.id.data, *message.contents);
+    rpc_timers_.get_branch_timer.AddResponse(message.id.data, message.contents);
   }
   catch (const maidsafe_error& error) {
     if (error.code() != NoSuchElement())
@@ -173,7 +188,7 @@ void MaidNodeService::HandleMessage(const CreateAccountResponse& message,
                                     const CreateAccountResponse::Receiver& /*receiver*/) {
   LOG(kInfo) << "Get response for CreateAccount";
   try {
-    rpc_timers_.create_account_timer.AddResponse(message.id.data, *message.contents);
+    rpc_timers_.create_account_timer.AddResponse(message.id.data, message.contents);
   }
   catch (const maidsafe_error& error) {
     if (error.code() != NoSuchElement())
@@ -188,7 +203,7 @@ void MaidNodeService::HandleMessage(const CreateVersionTreeResponse& message,
                                     const CreateVersionTreeResponse::Receiver& /*receiver*/) {
   LOG(kInfo) << "Get response for CreateVersionTree";
   try {
-    rpc_timers_.create_version_tree_timer.AddResponse(message.id.data, *message.contents);
+    rpc_timers_.create_version_tree_timer.AddResponse(message.id.data, message.contents);
   }
   catch (const maidsafe_error& error) {
     if (error.code() != NoSuchElement())
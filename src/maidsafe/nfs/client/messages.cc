@@ -18,7 +18,11 @@
 
 #include "maidsafe/nfs/client/messages.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <string>
+#include <system_error>
 
 #include "maidsafe/nfs/utils.h"
 #include "maidsafe/nfs/client/messages.pb.h"
@@ -29,6 +33,69 @@ namespace nfs_client {
 
 namespace {
 
+// The value of each enumerator is the category id sent on the wire, so existing values must never
+// be changed or reused.
+enum class ErrorCategoryId : int32_t {
+  kCommon = 0,
+  kAsymm = 1,
+  kPassport = 2,
+  kNfs = 3,
+  kRouting = 4,
+  kDrive = 5,
+  kVault = 6,
+  kApi = 7,
+  kUnknown
+};
+
+std::atomic<bool> write_error_category_names(true);
+
+typedef maidsafe_error (*MakeErrorFunctor)(int error_value);
+
+template <typename ErrorEnum>
+maidsafe_error MakeErrorFromValue(int error_value) {
+  return MakeError(static_cast<ErrorEnum>(error_value));
+}
+
+// Indexed by ErrorCategoryId.
+const MakeErrorFunctor kMakeErrorFunctors[] = {
+    &MakeErrorFromValue<CommonErrors>,   &MakeErrorFromValue<AsymmErrors>,
+    &MakeErrorFromValue<PassportErrors>, &MakeErrorFromValue<NfsErrors>,
+    &MakeErrorFromValue<RoutingErrors>,  &MakeErrorFromValue<DriveErrors>,
+    &MakeErrorFromValue<VaultErrors>,    &MakeErrorFromValue<ApiErrors>};
+
+static_assert(sizeof(kMakeErrorFunctors) / sizeof(kMakeErrorFunctors[0]) ==
+                  static_cast<size_t>(ErrorCategoryId::kUnknown),
+              "Every ErrorCategoryId must have a corresponding MakeErrorFunctor.");
+
+ErrorCategoryId GetErrorCategoryId(const std::error_category& category) {
+  if (&category == &GetCommonCategory())
+    return ErrorCategoryId::kCommon;
+  if (&category == &GetAsymmCategory())
+    return ErrorCategoryId::kAsymm;
+  if (&category == &GetPassportCategory())
+    return ErrorCategoryId::kPassport;
+  if (&category == &GetNfsCategory())
+    return ErrorCategoryId::kNfs;
+  if (&category == &GetRoutingCategory())
+    return ErrorCategoryId::kRouting;
+  if (&category == &GetDriveCategory())
+    return ErrorCategoryId::kDrive;
+  if (&category == &GetVaultCategory())
+    return ErrorCategoryId::kVault;
+  if (&category == &GetApiCategory())
+    return ErrorCategoryId::kApi;
+  return ErrorCategoryId::kUnknown;
+}
+
+maidsafe_error GetError(int error_value, int32_t error_category_id) {
+  if (error_category_id < 0 ||
+      error_category_id >= static_cast<int32_t>(ErrorCategoryId::kUnknown)) {
+    BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
+  }
+  return kMakeErrorFunctors[error_category_id](error_value);
+}
+
+// Only used to parse ReturnCodes from peers which predate the numeric category id.
 maidsafe_error GetError(int error_value, const std::string& error_category_name) {
   if (error_category_name == std::string(GetCommonCategory().name()))
     return MakeError(static_cast<CommonErrors>(error_value));
@@ -50,14 +117,53 @@ maidsafe_error GetError(int error_value, const std::string& error_category_name)
   BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
 }
 
+maidsafe_error GetError(const protobuf::ReturnCode& proto_return_code) {
+  if (proto_return_code.has_error_category_id())
+    return GetError(proto_return_code.error_value(), proto_return_code.error_category_id());
+  if (proto_return_code.has_error_category_name())
+    return GetError(proto_return_code.error_value(), proto_return_code.error_category_name());
+  BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
+}
+
+// The following parse and set the sub-messages embedded in the flattened protobuf messages,
+// avoiding a separate serialise or parse (and protobuf object) per nested field.
+ReturnCode ParseReturnCode(const protobuf::ReturnCode& proto_return_code) {
+  return ReturnCode(GetError(proto_return_code));
+}
+
+void SetReturnCode(const ReturnCode& return_code, protobuf::ReturnCode* proto_return_code) {
+  proto_return_code->set_error_value(return_code.value.code().value());
+  auto category_id(GetErrorCategoryId(return_code.value.code().category()));
+  if (category_id != ErrorCategoryId::kUnknown)
+    proto_return_code->set_error_category_id(static_cast<int32_t>(category_id));
+  if (category_id == ErrorCategoryId::kUnknown ||
+      write_error_category_names.load(std::memory_order_relaxed)) {
+    proto_return_code->set_error_category_name(return_code.value.code().category().name());
+  }
+}
+
+nfs_vault::DataName ParseDataName(const protobuf::DataName& proto_data_name) {
+  return nfs_vault::DataName(static_cast<DataTagValue>(proto_data_name.type()),
+                             Identity(proto_data_name.raw_name()));
+}
+
+void SetDataName(const nfs_vault::DataName& data_name, protobuf::DataName* proto_data_name) {
+  proto_data_name->set_type(static_cast<uint32_t>(data_name.type));
+  proto_data_name->set_raw_name(data_name.raw_name.string());
+}
+
 }  // unnamed namespace
 
 // ==================== ReturnCode =================================================================
+void SetWriteErrorCategoryNames(bool write) {
+  write_error_category_names.store(write, std::memory_order_relaxed);
+}
+
 ReturnCode::ReturnCode(const maidsafe_error& error) : value(error) {}
 
 ReturnCode::ReturnCode(const ReturnCode& other) : value(other.value) {}
 
-ReturnCode::ReturnCode(ReturnCode&& other) : value(std::move(other.value)) {}
+ReturnCode::ReturnCode(ReturnCode&& other) MAIDSAFE_NOEXCEPT : value(std::move(other.value)) {}
 
 ReturnCode& ReturnCode::operator=(ReturnCode other) {
   swap(*this, other);
@@ -65,19 +171,18 @@ ReturnCode& ReturnCode::operator=(ReturnCode other) {
 }
 
 ReturnCode::ReturnCode(const std::string& serialised_copy)
-    : value([&serialised_copy] {
+    : value([&serialised_copy]() -> maidsafe_error {
         protobuf::ReturnCode proto_copy;
         if (!proto_copy.ParseFromString(serialised_copy)) {
           LOG(kError) << "ReturnCode parsing error";
           BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
         }
-        return GetError(proto_copy.error_value(), proto_copy.error_category_name());
+        return GetError(proto_copy);
       }()) {}
 
 std::string ReturnCode::Serialise() const {
   protobuf::ReturnCode proto_copy;
-  proto_copy.set_error_value(value.code().value());
-  proto_copy.set_error_category_name(value.code().category().name());
+  SetReturnCode(*this, &proto_copy);
   return proto_copy.SerializeAsString();
 }
 
@@ -100,7 +205,8 @@ AvailableSizeAndReturnCode::AvailableSizeAndReturnCode(uint64_t size,
 AvailableSizeAndReturnCode::AvailableSizeAndReturnCode(const AvailableSizeAndReturnCode& other)
     : available_size(other.available_size), return_code(other.return_code) {}
 
-AvailableSizeAndReturnCode::AvailableSizeAndReturnCode(AvailableSizeAndReturnCode&& other)
+AvailableSizeAndReturnCode::AvailableSizeAndReturnCode(
+    AvailableSizeAndReturnCode&& other) MAIDSAFE_NOEXCEPT
     : available_size(std::move(other.available_size)), return_code(std::move(other.return_code)) {}
 
 AvailableSizeAndReturnCode& AvailableSizeAndReturnCode::operator=(
@@ -117,13 +223,13 @@ AvailableSizeAndReturnCode::AvailableSizeAndReturnCode(const std::string& serial
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
   }
   available_size = nfs_vault::AvailableSize(proto_copy.serialised_available_size());
-  return_code = ReturnCode(proto_copy.serialised_return_code());
+  return_code = ParseReturnCode(proto_copy.return_code());
 }
 
 std::string AvailableSizeAndReturnCode::Serialise() const {
   protobuf::AvailableSizeAndReturnCode proto_copy;
   proto_copy.set_serialised_available_size(available_size.Serialise());
-  proto_copy.set_serialised_return_code(return_code.Serialise());
+  SetReturnCode(return_code, proto_copy.mutable_return_code());
   return proto_copy.SerializeAsString();
 }
 
@@ -146,7 +252,7 @@ DataNameAndReturnCode::DataNameAndReturnCode(nfs_vault::DataName data_name, Retu
 DataNameAndReturnCode::DataNameAndReturnCode(const DataNameAndReturnCode& other)
     : name(other.name), return_code(other.return_code) {}
 
-DataNameAndReturnCode::DataNameAndReturnCode(DataNameAndReturnCode&& other)
+DataNameAndReturnCode::DataNameAndReturnCode(DataNameAndReturnCode&& other) MAIDSAFE_NOEXCEPT
     : name(std::move(other.name)), return_code(std::move(other.return_code)) {}
 
 DataNameAndReturnCode& DataNameAndReturnCode::operator=(DataNameAndReturnCode other) {
@@ -159,14 +265,14 @@ DataNameAndReturnCode::DataNameAndReturnCode(const std::string& serialised_copy)
   protobuf::DataNameAndReturnCode proto_copy;
   if (!proto_copy.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
-  name = nfs_vault::DataName(proto_copy.serialised_name());
-  return_code = ReturnCode(proto_copy.serialised_return_code());
+  name = ParseDataName(proto_copy.name());
+  return_code = ParseReturnCode(proto_copy.return_code());
 }
 
 std::string DataNameAndReturnCode::Serialise() const {
   protobuf::DataNameAndReturnCode proto_copy;
-  proto_copy.set_serialised_name(name.Serialise());
-  proto_copy.set_serialised_return_code(return_code.Serialise());
+  SetDataName(name, proto_copy.mutable_name());
+  SetReturnCode(return_code, proto_copy.mutable_return_code());
   return proto_copy.SerializeAsString();
 }
 
@@ -191,7 +297,8 @@ DataNameAndSizeAndReturnCode::DataNameAndSizeAndReturnCode(
     const DataNameAndSizeAndReturnCode& other)
     : name(other.name), size(other.size), return_code(other.return_code) {}
 
-DataNameAndSizeAndReturnCode::DataNameAndSizeAndReturnCode(DataNameAndSizeAndReturnCode&& other)
+DataNameAndSizeAndReturnCode::DataNameAndSizeAndReturnCode(
+    DataNameAndSizeAndReturnCode&& other) MAIDSAFE_NOEXCEPT
     : name(std::move(other.name)), size(std::move(other.size)),
       return_code(std::move(other.return_code)) {}
 
@@ -206,16 +313,16 @@ DataNameAndSizeAndReturnCode::DataNameAndSizeAndReturnCode(const std::string& se
   protobuf::DataNameAndSizeAndReturnCode proto_copy;
   if (!proto_copy.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
-  name = nfs_vault::DataName(proto_copy.serialised_name());
+  name = ParseDataName(proto_copy.name());
   size = proto_copy.size();
-  return_code = ReturnCode(proto_copy.serialised_return_code());
+  return_code = ParseReturnCode(proto_copy.return_code());
 }
 
 std::string DataNameAndSizeAndReturnCode::Serialise() const {
   protobuf::DataNameAndSizeAndReturnCode proto_copy;
-  proto_copy.set_serialised_name(name.Serialise());
+  SetDataName(name, proto_copy.mutable_name());
   proto_copy.set_size(size);
-  proto_copy.set_serialised_return_code(return_code.Serialise());
+  SetReturnCode(return_code, proto_copy.mutable_return_code());
   return proto_copy.SerializeAsString();
 }
 
@@ -232,22 +339,21 @@ void swap(DataNameAndSizeAndReturnCode& lhs, DataNameAndSizeAndReturnCode& rhs)
 
 // ==================== DataNamesAndReturnCode =====================================================
 DataNamesAndReturnCode::DataNamesAndReturnCode(const ReturnCode& code)
-    : names(),
+    : names_(),
       return_code(code) {}
 
-DataNamesAndReturnCode::DataNamesAndReturnCode(const std::vector<nfs_vault::DataName>& data_names,
+DataNamesAndReturnCode::DataNamesAndReturnCode(std::vector<nfs_vault::DataName> data_names,
                                                const ReturnCode& code)
-    : names(),
+    : names_(std::move(data_names)),
       return_code(code) {
-  for (auto data_name : data_names)
-    names.insert(data_name);
+  SortNames();
 }
 
 DataNamesAndReturnCode::DataNamesAndReturnCode(const DataNamesAndReturnCode& other)
-    : names(other.names), return_code(other.return_code) {}
+    : names_(other.names_), return_code(other.return_code) {}
 
-DataNamesAndReturnCode::DataNamesAndReturnCode(DataNamesAndReturnCode&& other)
-    : names(std::move(other.names)), return_code(std::move(other.return_code)) {}
+DataNamesAndReturnCode::DataNamesAndReturnCode(DataNamesAndReturnCode&& other) MAIDSAFE_NOEXCEPT
+    : names_(std::move(other.names_)), return_code(std::move(other.return_code)) {}
 
 DataNamesAndReturnCode& DataNamesAndReturnCode::operator=(DataNamesAndReturnCode other) {
   swap(*this, other);
@@ -255,38 +361,110 @@ DataNamesAndReturnCode& DataNamesAndReturnCode::operator=(DataNamesAndReturnCode
 }
 
 void DataNamesAndReturnCode::AddDataName(const DataTagValue& tag_value, const Identity& identity) {
-  names.insert(nfs_vault::DataName(tag_value, identity));
+  AddDataName(nfs_vault::DataName(tag_value, identity));
+}
+
+void DataNamesAndReturnCode::AddDataName(nfs_vault::DataName data_name) {
+  auto itr(std::lower_bound(std::begin(names_), std::end(names_), data_name));
+  if (itr == std::end(names_) || data_name < *itr)
+    names_.insert(itr, std::move(data_name));
+}
+
+bool DataNamesAndReturnCode::Contains(const nfs_vault::DataName& data_name) const {
+  return std::binary_search(std::begin(names_), std::end(names_), data_name);
+}
+
+void DataNamesAndReturnCode::SortNames() {
+  std::sort(std::begin(names_), std::end(names_));
+  // Duplicates are removed using the equivalence defined by operator<, not operator==, as the names
+  // are sorted (and later searched) by that order.
+  names_.erase(std::unique(std::begin(names_), std::end(names_),
+                           [](const nfs_vault::DataName& lhs, const nfs_vault::DataName& rhs) {
+                             return !(lhs < rhs) && !(rhs < lhs);
+                           }),
+               std::end(names_));
 }
 
 DataNamesAndReturnCode::DataNamesAndReturnCode(const std::string& serialised_copy)
-    : names(),
+    : names_(),
       return_code() {
   protobuf::DataNamesAndReturnCode names_proto;
   if (!names_proto.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
-  for (auto index(0); index < names_proto.serialised_name_size(); ++index)
-    names.insert(nfs_vault::DataName(std::string(names_proto.serialised_name(index))));
-  return_code = nfs_client::ReturnCode(names_proto.serialised_return_code());
+  names_.reserve(names_proto.name_size());
+  for (auto index(0); index < names_proto.name_size(); ++index)
+    names_.push_back(ParseDataName(names_proto.name(index)));
+  // Senders serialise in sorted order, so this is normally just the check.
+  if (!std::is_sorted(std::begin(names_), std::end(names_)))
+    SortNames();
+  return_code = ParseReturnCode(names_proto.return_code());
 }
 
 std::string DataNamesAndReturnCode::Serialise() const {
   protobuf::DataNamesAndReturnCode names_proto;
-  names_proto.set_serialised_return_code(return_code.Serialise());
-  for (const auto& name : names) {
-    auto name_proto(names_proto.add_serialised_name());
-    *name_proto = name.Serialise();
-  }
+  SetReturnCode(return_code, names_proto.mutable_return_code());
+  names_proto.mutable_name()->Reserve(static_cast<int>(names_.size()));
+  for (const auto& name : names_)
+    SetDataName(name, names_proto.add_name());
   return names_proto.SerializeAsString();
 }
 
 bool operator==(const DataNamesAndReturnCode& lhs, const DataNamesAndReturnCode& rhs) {
-  return  lhs.return_code == rhs.return_code && lhs.names == rhs.names;
+  return  lhs.return_code == rhs.return_code && lhs.names() == rhs.names();
 }
 
 void swap(DataNamesAndReturnCode& lhs, DataNamesAndReturnCode& rhs) MAIDSAFE_NOEXCEPT {
   using std::swap;
   swap(lhs.return_code, rhs.return_code);
-  swap(lhs.names, rhs.names);
+  swap(lhs.names_, rhs.names_);
+}
+
+// ==================== DataNameAndReturnCodes =====================================================
+DataNameAndReturnCodes::DataNameAndReturnCodes() : results() {}
+
+DataNameAndReturnCodes::DataNameAndReturnCodes(std::vector<DataNameAndReturnCode> results_in)
+    : results(std::move(results_in)) {}
+
+DataNameAndReturnCodes::DataNameAndReturnCodes(const DataNameAndReturnCodes& other)
+    : results(other.results) {}
+
+DataNameAndReturnCodes::DataNameAndReturnCodes(DataNameAndReturnCodes&& other) MAIDSAFE_NOEXCEPT
+    : results(std::move(other.results)) {}
+
+DataNameAndReturnCodes& DataNameAndReturnCodes::operator=(DataNameAndReturnCodes other) {
+  swap(*this, other);
+  return *this;
+}
+
+DataNameAndReturnCodes::DataNameAndReturnCodes(const std::string& serialised_copy) : results() {
+  protobuf::DataNameAndReturnCodes proto_copy;
+  if (!proto_copy.ParseFromString(serialised_copy))
+    BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
+  results.reserve(proto_copy.results_size());
+  for (int index(0); index < proto_copy.results_size(); ++index) {
+    const auto& proto_result(proto_copy.results(index));
+    results.push_back(DataNameAndReturnCode(ParseDataName(proto_result.name()),
+                                            ParseReturnCode(proto_result.return_code())));
+  }
+}
+
+std::string DataNameAndReturnCodes::Serialise() const {
+  protobuf::DataNameAndReturnCodes proto_copy;
+  for (const auto& result : results) {
+    auto proto_result(proto_copy.add_results());
+    SetDataName(result.name, proto_result->mutable_name());
+    SetReturnCode(result.return_code, proto_result->mutable_return_code());
+  }
+  return proto_copy.SerializeAsString();
+}
+
+bool operator==(const DataNameAndReturnCodes& lhs, const DataNameAndReturnCodes& rhs) {
+  return lhs.results == rhs.results;
+}
+
+void swap(DataNameAndReturnCodes& lhs, DataNameAndReturnCodes& rhs) MAIDSAFE_NOEXCEPT {
+  using std::swap;
+  swap(lhs.results, rhs.results);
 }
 
 // ==================== DataNameVersionAndReturnCode ===============================================
@@ -297,7 +475,8 @@ DataNameVersionAndReturnCode::DataNameVersionAndReturnCode(
     const DataNameVersionAndReturnCode& other)
     : data_name_and_version(other.data_name_and_version), return_code(other.return_code) {}
 
-DataNameVersionAndReturnCode::DataNameVersionAndReturnCode(DataNameVersionAndReturnCode&& other)
+DataNameVersionAndReturnCode::DataNameVersionAndReturnCode(
+    DataNameVersionAndReturnCode&& other) MAIDSAFE_NOEXCEPT
     : data_name_and_version(std::move(other.data_name_and_version)),
       return_code(std::move(other.return_code)) {}
 
@@ -314,13 +493,13 @@ DataNameVersionAndReturnCode::DataNameVersionAndReturnCode(const std::string& se
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
   data_name_and_version =
       nfs_vault::DataNameAndVersion(proto_copy.serialised_data_name_and_version());
-  return_code = ReturnCode(proto_copy.serialised_return_code());
+  return_code = ParseReturnCode(proto_copy.return_code());
 }
 
 std::string DataNameVersionAndReturnCode::Serialise() const {
   protobuf::DataNameVersionAndReturnCode proto_copy;
   proto_copy.set_serialised_data_name_and_version(data_name_and_version.Serialise());
-  proto_copy.set_serialised_return_code(return_code.Serialise());
+  SetReturnCode(return_code, proto_copy.mutable_return_code());
   return proto_copy.SerializeAsString();
 }
 
@@ -344,7 +523,7 @@ DataNameOldNewVersionAndReturnCode::DataNameOldNewVersionAndReturnCode(
     : data_name_old_new_version(other.data_name_old_new_version), return_code(other.return_code) {}
 
 DataNameOldNewVersionAndReturnCode::DataNameOldNewVersionAndReturnCode(
-    DataNameOldNewVersionAndReturnCode&& other)
+    DataNameOldNewVersionAndReturnCode&& other) MAIDSAFE_NOEXCEPT
     : data_name_old_new_version(std::move(other.data_name_old_new_version)),
       return_code(std::move(other.return_code)) {}
 
@@ -362,13 +541,13 @@ DataNameOldNewVersionAndReturnCode::DataNameOldNewVersionAndReturnCode(
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
   data_name_old_new_version =
       nfs_vault::DataNameOldNewVersion(proto_copy.serialised_data_name_old_new_version());
-  return_code = ReturnCode(proto_copy.serialised_return_code());
+  return_code = ParseReturnCode(proto_copy.return_code());
 }
 
 std::string DataNameOldNewVersionAndReturnCode::Serialise() const {
   protobuf::DataNameOldNewVersionAndReturnCode proto_copy;
   proto_copy.set_serialised_data_name_old_new_version(data_name_old_new_version.Serialise());
-  proto_copy.set_serialised_return_code(return_code.Serialise());
+  SetReturnCode(return_code, proto_copy.mutable_return_code());
   return proto_copy.SerializeAsString();
 }
 
@@ -391,7 +570,7 @@ DataAndReturnCode::DataAndReturnCode() : data(), return_code() {}
 DataAndReturnCode::DataAndReturnCode(const DataAndReturnCode& other)
     : data(other.data), return_code(other.return_code) {}
 
-DataAndReturnCode::DataAndReturnCode(DataAndReturnCode&& other)
+DataAndReturnCode::DataAndReturnCode(DataAndReturnCode&& other) MAIDSAFE_NOEXCEPT
     : data(std::move(other.data)), return_code(std::move(other.return_code)) {}
 
 DataAndReturnCode& DataAndReturnCode::operator=(DataAndReturnCode other) {
@@ -404,13 +583,13 @@ DataAndReturnCode::DataAndReturnCode(const std::string& serialised_copy) : data(
   if (!proto_copy.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
   data = nfs_vault::DataNameAndContent(proto_copy.serialised_data_name_and_content());
-  return_code = ReturnCode(proto_copy.serialised_return_code());
+  return_code = ParseReturnCode(proto_copy.return_code());
 }
 
 std::string DataAndReturnCode::Serialise() const {
   protobuf::DataAndReturnCode proto_copy;
   proto_copy.set_serialised_data_name_and_content(data.Serialise());
-  proto_copy.set_serialised_return_code(return_code.Serialise());
+  SetReturnCode(return_code, proto_copy.mutable_return_code());
   return proto_copy.SerializeAsString();
 }
 
@@ -438,7 +617,7 @@ DataNameAndContentOrReturnCode::DataNameAndContentOrReturnCode(
         : name(other.name), content(other.content), return_code(other.return_code) {}
 
 DataNameAndContentOrReturnCode::DataNameAndContentOrReturnCode(
-    DataNameAndContentOrReturnCode&& other)
+    DataNameAndContentOrReturnCode&& other) MAIDSAFE_NOEXCEPT
         : name(std::move(other.name)), content(std::move(other.content)),
           return_code(std::move(other.return_code)) {}
 
@@ -454,13 +633,13 @@ DataNameAndContentOrReturnCode::DataNameAndContentOrReturnCode(const std::string
   if (!proto_copy.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
 
-  name = nfs_vault::DataName(proto_copy.serialised_name());
+  name = ParseDataName(proto_copy.name());
 
   if (proto_copy.has_content())
-    content.reset(nfs_vault::Content(proto_copy.content()));
-  if (proto_copy.has_serialised_return_code()) {
-    return_code.reset(ReturnCode(proto_copy.serialised_return_code()));
-  }
+    content.reset(
+        nfs_vault::Content(nfs::SharedBuffer(std::move(*proto_copy.mutable_content()))));
+  if (proto_copy.has_return_code())
+    return_code.reset(ParseReturnCode(proto_copy.return_code()));
   if (!nfs::CheckMutuallyExclusive(content, return_code)) {
     assert(false);
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
@@ -474,11 +653,11 @@ std::string DataNameAndContentOrReturnCode::Serialise() const {
   }
   protobuf::DataNameAndContentOrReturnCode proto_copy;
 
-  proto_copy.set_serialised_name(name.Serialise());
+  SetDataName(name, proto_copy.mutable_name());
   if (content)
     proto_copy.set_content(content->Serialise());
   else
-    proto_copy.set_serialised_return_code(return_code->Serialise());
+    SetReturnCode(*return_code, proto_copy.mutable_return_code());
   return proto_copy.SerializeAsString();
 }
 
@@ -512,7 +691,7 @@ StructuredDataNameAndContentOrReturnCode::StructuredDataNameAndContentOrReturnCo
       data_name_and_return_code(other.data_name_and_return_code) {}
 
 StructuredDataNameAndContentOrReturnCode::StructuredDataNameAndContentOrReturnCode(
-    StructuredDataNameAndContentOrReturnCode&& other)
+    StructuredDataNameAndContentOrReturnCode&& other) MAIDSAFE_NOEXCEPT
     : structured_data(std::move(other.structured_data)),
       data_name_and_return_code(std::move(other.data_name_and_return_code)) {}
 
@@ -531,9 +710,11 @@ StructuredDataNameAndContentOrReturnCode::StructuredDataNameAndContentOrReturnCo
 
   if (proto_copy.has_serialised_structured_data())
     structured_data.reset(StructuredData(proto_copy.serialised_structured_data()));
-  if (proto_copy.has_serialised_data_name_and_return_code()) {
+  if (proto_copy.has_data_name_and_return_code()) {
+    const auto& proto_data_name_and_return_code(proto_copy.data_name_and_return_code());
     data_name_and_return_code.reset(
-        DataNameAndReturnCode(proto_copy.serialised_data_name_and_return_code()));
+        DataNameAndReturnCode(ParseDataName(proto_data_name_and_return_code.name()),
+                              ParseReturnCode(proto_data_name_and_return_code.return_code())));
   }
   if (!nfs::CheckMutuallyExclusive(structured_data, data_name_and_return_code)) {
     assert(false);
@@ -548,10 +729,14 @@ std::string StructuredDataNameAndContentOrReturnCode::Serialise() const {
   }
   protobuf::StructuredDataNameAndContentOrReturnCode proto_copy;
 
-  if (structured_data)
+  if (structured_data) {
     proto_copy.set_serialised_structured_data(structured_data->Serialise());
-  else
-    proto_copy.set_serialised_data_name_and_return_code(data_name_and_return_code->Serialise());
+  } else {
+    auto proto_data_name_and_return_code(proto_copy.mutable_data_name_and_return_code());
+    SetDataName(data_name_and_return_code->name, proto_data_name_and_return_code->mutable_name());
+    SetReturnCode(data_name_and_return_code->return_code,
+                  proto_data_name_and_return_code->mutable_return_code());
+  }
   return proto_copy.SerializeAsString();
 }
 
@@ -582,7 +767,7 @@ TipOfTreeAndReturnCode::TipOfTreeAndReturnCode(
     const TipOfTreeAndReturnCode& other)
         : tip_of_tree(other.tip_of_tree), return_code(other.return_code) {}
 
-TipOfTreeAndReturnCode::TipOfTreeAndReturnCode(TipOfTreeAndReturnCode&& other)
+TipOfTreeAndReturnCode::TipOfTreeAndReturnCode(TipOfTreeAndReturnCode&& other) MAIDSAFE_NOEXCEPT
         : tip_of_tree(std::move(other.tip_of_tree)), return_code(std::move(other.return_code)) {}
 
 TipOfTreeAndReturnCode& TipOfTreeAndReturnCode::operator=(TipOfTreeAndReturnCode other) {
@@ -600,7 +785,7 @@ TipOfTreeAndReturnCode::TipOfTreeAndReturnCode(const std::string& serialised_cop
                           proto_copy.serialised_tip_of_tree()));
   }
 
-  return_code = ReturnCode(proto_copy.serialised_return_code());
+  return_code = ParseReturnCode(proto_copy.return_code());
 }
 
 std::string TipOfTreeAndReturnCode::Serialise() const {
@@ -609,7 +794,7 @@ std::string TipOfTreeAndReturnCode::Serialise() const {
   if (tip_of_tree)
     proto_copy.set_serialised_tip_of_tree(tip_of_tree->Serialise());
 
-  proto_copy.set_serialised_return_code(return_code.Serialise());
+  SetReturnCode(return_code, proto_copy.mutable_return_code());
   return proto_copy.SerializeAsString();
 }
 
@@ -647,7 +832,7 @@ DataNameAndSizeAndSpaceAndReturnCode::DataNameAndSizeAndSpaceAndReturnCode(
       return_code(code_in) {}
 
 DataNameAndSizeAndSpaceAndReturnCode::DataNameAndSizeAndSpaceAndReturnCode(
-    DataNameAndSizeAndSpaceAndReturnCode&& other)
+    DataNameAndSizeAndSpaceAndReturnCode&& other) MAIDSAFE_NOEXCEPT
     : name(std::move(other.name)),
       size(std::move(other.size)),
       available_space(std::move(other.available_space)),
@@ -659,18 +844,18 @@ DataNameAndSizeAndSpaceAndReturnCode::DataNameAndSizeAndSpaceAndReturnCode(
   if (!proto.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
 
-  name = nfs_vault::DataName(proto.serialised_name());
+  name = ParseDataName(proto.name());
   size = proto.size();
   available_space = proto.space();
-  return_code = nfs_client::ReturnCode(proto.serialised_return_code());
+  return_code = ParseReturnCode(proto.return_code());
 }
 
 std::string DataNameAndSizeAndSpaceAndReturnCode::Serialise() const {
   protobuf::DataNameAndSizeAndSpaceAndReturnCode proto_copy;
-  proto_copy.set_serialised_name(name.Serialise());
+  SetDataName(name, proto_copy.mutable_name());
   proto_copy.set_size(size);
   proto_copy.set_space(available_space);
-  proto_copy.set_serialised_return_code(return_code.Serialise());
+  SetReturnCode(return_code, proto_copy.mutable_return_code());
   return proto_copy.SerializeAsString();
 }
 
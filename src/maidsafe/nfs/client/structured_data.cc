@@ -18,7 +18,13 @@
 
 #include "maidsafe/nfs/client/structured_data.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "maidsafe/common/error.h"
 
@@ -28,48 +34,173 @@ namespace maidsafe {
 
 namespace nfs_client {
 
+namespace {
+
+typedef StructuredDataVersions::VersionName VersionName;
+
+std::atomic<bool> write_packed_versions(false);
+
+// Returns false if the ids of 'versions' can't be stored contiguously with a common size.
+bool GetPackedIdSize(const std::vector<VersionName>& versions, uint32_t& id_size) {
+  id_size = 0;
+  for (const auto& version : versions) {
+    if (!version.id->IsInitialised())
+      return false;
+    auto size(static_cast<uint32_t>(version.id->string().size()));
+    if (id_size != 0 && size != id_size)
+      return false;
+    id_size = size;
+  }
+  return true;
+}
+
+void ParsePackedVersions(const protobuf::StructuredData& proto_structured_data,
+                         std::vector<VersionName>& versions) {
+  const auto count(static_cast<size_t>(proto_structured_data.index_deltas_size()));
+  const std::string& ids(proto_structured_data.ids());
+  const size_t id_size(proto_structured_data.id_size());
+  if (ids.size() != count * id_size || (count != 0 && id_size == 0))
+    BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
+  versions.reserve(count);
+  uint64_t index(0);
+  for (size_t i(0); i < count; ++i) {
+    index += static_cast<uint64_t>(proto_structured_data.index_deltas(static_cast<int>(i)));
+    versions.emplace_back(index, ImmutableData::Name(Identity(ids.substr(i * id_size, id_size))));
+  }
+}
+
+const std::string& IdString(const VersionName& version) {
+  static const std::string kUninitialisedId;
+  return version.id->IsInitialised() ? version.id->string() : kUninitialisedId;
+}
+
+// Order-independent, so that equal sets of versions have equal digests however they're ordered.
+uint64_t CalculateDigest(const std::vector<VersionName>& versions) {
+  std::hash<std::string> hash_id;
+  uint64_t digest(0);
+  for (const auto& version : versions) {
+    uint64_t hash(hash_id(IdString(version)) ^ (version.index * 0x9e3779b97f4a7c15ULL));
+    hash ^= hash >> 29;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 32;
+    digest += hash;
+  }
+  return digest;
+}
+
+std::vector<const VersionName*> SortedVersions(const std::vector<VersionName>& versions) {
+  std::vector<const VersionName*> sorted;
+  sorted.reserve(versions.size());
+  for (const auto& version : versions)
+    sorted.push_back(&version);
+  std::sort(std::begin(sorted), std::end(sorted),
+            [](const VersionName* lhs, const VersionName* rhs) {
+              return lhs->index != rhs->index ? lhs->index < rhs->index
+                                              : IdString(*lhs) < IdString(*rhs);
+            });
+  return sorted;
+}
+
+}  // unnamed namespace
+
 StructuredData::StructuredData(std::vector<StructuredDataVersions::VersionName> versions_in)
-    : versions(std::move(versions_in)) {}
+    : versions_(std::move(versions_in)), digest_(0), has_digest_(false) {}
 
-StructuredData::StructuredData() : versions() {}
+StructuredData::StructuredData() : versions_(), digest_(0), has_digest_(false) {}
 
-StructuredData::StructuredData(const StructuredData& other) : versions(other.versions) {}
+StructuredData::StructuredData(const StructuredData& other)
+    : versions_(other.versions_), digest_(other.digest_.load()),
+      has_digest_(other.has_digest_.load()) {}
 
-StructuredData::StructuredData(StructuredData&& other) : versions(std::move(other.versions)) {}
+StructuredData::StructuredData(StructuredData&& other) MAIDSAFE_NOEXCEPT
+    : versions_(std::move(other.versions_)), digest_(other.digest_.load()),
+      has_digest_(other.has_digest_.load()) {
+  other.has_digest_ = false;
+}
 
 StructuredData& StructuredData::operator=(StructuredData other) {
   swap(*this, other);
   return *this;
 }
 
-StructuredData::StructuredData(const std::string& serialised_copy) : versions() {
+StructuredData::StructuredData(const std::string& serialised_copy)
+    : versions_(), digest_(0), has_digest_(false) {
   protobuf::StructuredData proto_structured_data;
   if (!proto_structured_data.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
-  for (auto i(0); i < proto_structured_data.serialised_versions_size(); ++i)
-    versions.emplace_back(proto_structured_data.serialised_versions(i));
+  if (proto_structured_data.has_id_size()) {
+    ParsePackedVersions(proto_structured_data, versions_);
+  } else {
+    versions_.reserve(proto_structured_data.serialised_versions_size());
+    for (auto i(0); i < proto_structured_data.serialised_versions_size(); ++i)
+      versions_.emplace_back(proto_structured_data.serialised_versions(i));
+  }
 }
 
 std::string StructuredData::Serialise() const {
   protobuf::StructuredData proto_structured_data;
-  for (const auto& version : versions)
-    proto_structured_data.add_serialised_versions(version.Serialise());
+  uint32_t id_size(0);
+  if (versions_.empty() || !write_packed_versions.load(std::memory_order_relaxed) ||
+      !GetPackedIdSize(versions_, id_size)) {
+    for (const auto& version : versions_)
+      proto_structured_data.add_serialised_versions(version.Serialise());
+    return proto_structured_data.SerializeAsString();
+  }
+
+  std::string ids;
+  ids.reserve(versions_.size() * id_size);
+  uint64_t previous_index(0);
+  for (const auto& version : versions_) {
+    proto_structured_data.add_index_deltas(static_cast<int64_t>(version.index - previous_index));
+    previous_index = version.index;
+    ids += version.id->string();
+  }
+  proto_structured_data.set_id_size(id_size);
+  proto_structured_data.mutable_ids()->swap(ids);
   return proto_structured_data.SerializeAsString();
 }
 
+std::vector<StructuredDataVersions::VersionName>& StructuredData::mutable_versions() {
+  has_digest_ = false;
+  return versions_;
+}
+
+uint64_t StructuredData::digest() const {
+  if (!has_digest_) {
+    digest_ = CalculateDigest(versions_);
+    has_digest_ = true;
+  }
+  return digest_;
+}
+
+void SetWritePackedVersions(bool write) {
+  write_packed_versions.store(write, std::memory_order_relaxed);
+}
+
 bool operator==(const StructuredData& lhs, const StructuredData& rhs) {
-  if (lhs.versions.size() != rhs.versions.size())
+  if (lhs.versions().size() != rhs.versions().size())
     return false;
-  for (const auto& version : lhs.versions) {
-    if (std::find(rhs.versions.begin(), rhs.versions.end(), version) == rhs.versions.end())
-      return false;
-  }
-  return true;
+  // Responses from different group members normally list the versions in the same order.
+  if (lhs.versions() == rhs.versions())
+    return true;
+  if (lhs.digest() != rhs.digest())
+    return false;
+  auto lhs_sorted(SortedVersions(lhs.versions())), rhs_sorted(SortedVersions(rhs.versions()));
+  return std::equal(std::begin(lhs_sorted), std::end(lhs_sorted), std::begin(rhs_sorted),
+                    [](const VersionName* lhs_version, const VersionName* rhs_version) {
+                      return *lhs_version == *rhs_version;
+                    });
 }
 
 void swap(StructuredData& lhs, StructuredData& rhs) MAIDSAFE_NOEXCEPT {
   using std::swap;
-  swap(lhs.versions, rhs.versions);
+  swap(lhs.versions_, rhs.versions_);
+  auto lhs_digest(lhs.digest_.load());
+  auto lhs_has_digest(lhs.has_digest_.load());
+  lhs.digest_ = rhs.digest_.load();
+  lhs.has_digest_ = rhs.has_digest_.load();
+  rhs.digest_ = lhs_digest;
+  rhs.has_digest_ = lhs_has_digest;
 }
 
 }  // namespace nfs_client
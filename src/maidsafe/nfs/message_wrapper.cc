@@ -18,6 +18,9 @@
 
 #include "maidsafe/nfs/message_wrapper.h"
 
+#include <atomic>
+#include <cstdint>
+
 #include "maidsafe/common/error.h"
 #include "maidsafe/common/utils.h"
 
@@ -29,9 +32,46 @@ namespace nfs {
 
 namespace detail {
 
+namespace {
+
+void AppendVarint(uint64_t value, std::string& output) {
+  while (value >= 0x80) {
+    output.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<char>(value));
+}
+
+// As protobuf encodes int32 fields: negative values are sign-extended to 64 bits.
+void AppendInt32(int32_t value, std::string& output) {
+  AppendVarint(static_cast<uint64_t>(static_cast<int64_t>(value)), output);
+}
+
+// Wire tags (field number << 3 | wire type) of the MessageWrapper fields.
+const char kActionTag(1 << 3);
+const char kSourcePersonaTag(2 << 3);
+const char kDestinationPersonaTag(3 << 3);
+const char kMessageIdTag(4 << 3);
+const char kSerialisedContentsTag((5 << 3) | 2);
+
+// Zero until the first id is requested, when it is seeded randomly.  It is a namespace-scope
+// object rather than a function-local static, since not all supported compilers make the
+// initialisation of function-local statics thread-safe.
+std::atomic<uint32_t> next_message_id(0);
+
+}  // unnamed namespace
+
+// Ids are taken from a randomly seeded atomic counter, so concurrent callers never race on (or
+// duplicate) an id within a process.  The counter wraps within the int32 range, as older peers
+// parse the id as int32, so after 2^32 ids it repeats, and ids drawn by different processes may
+// collide.
 MessageId GetNewMessageId() {
-  static int32_t random_element(RandomInt32());
-  return MessageId(random_element++);
+  if (next_message_id.load(std::memory_order_relaxed) == 0) {
+    uint32_t unseeded(0);
+    next_message_id.compare_exchange_strong(unseeded, RandomUint32() | 1,
+                                            std::memory_order_relaxed);
+  }
+  return MessageId(static_cast<int32_t>(next_message_id.fetch_add(1, std::memory_order_relaxed)));
 }
 
 std::string SerialiseMessageWrapper(const TypeErasedMessageWrapper& message_tuple) {
@@ -53,6 +93,31 @@ std::string SerialiseMessageWrapper(const TypeErasedMessageWrapper& message_tupl
   return proto_message_wrapper.SerializeAsString();
 }
 
+std::string SerialiseMessageWrapperHeader(MessageAction action, Persona source_persona,
+                                          Persona destination_persona) {
+  std::string serialised_header;
+  serialised_header.push_back(kActionTag);
+  AppendInt32(static_cast<int32_t>(action), serialised_header);
+  serialised_header.push_back(kSourcePersonaTag);
+  AppendInt32(static_cast<int32_t>(source_persona), serialised_header);
+  serialised_header.push_back(kDestinationPersonaTag);
+  AppendInt32(static_cast<int32_t>(destination_persona), serialised_header);
+  return serialised_header;
+}
+
+std::string SerialiseMessageWrapper(const std::string& serialised_header, MessageId message_id,
+                                    const std::string& serialised_contents) {
+  std::string serialised_message_wrapper;
+  serialised_message_wrapper.reserve(serialised_header.size() + serialised_contents.size() + 17);
+  serialised_message_wrapper.append(serialised_header);
+  serialised_message_wrapper.push_back(kMessageIdTag);
+  AppendInt32(message_id.data, serialised_message_wrapper);
+  serialised_message_wrapper.push_back(kSerialisedContentsTag);
+  AppendVarint(serialised_contents.size(), serialised_message_wrapper);
+  serialised_message_wrapper.append(serialised_contents);
+  return serialised_message_wrapper;
+}
+
 }  // namespace detail
 
 TypeErasedMessageWrapper ParseMessageWrapper(const std::string& serialised_message_wrapper) {
@@ -0,0 +1,73 @@
+/*  Copyright 2013 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#include "maidsafe/nfs/shared_buffer.h"
+
+#include <utility>
+
+#include "maidsafe/common/error.h"
+
+namespace maidsafe {
+
+namespace nfs {
+
+SharedBuffer::SharedBuffer() : data_() {}
+
+SharedBuffer::SharedBuffer(std::string data)
+    : data_(std::make_shared<const std::string>(std::move(data))) {}
+
+SharedBuffer::SharedBuffer(const NonEmptyString& data)
+    : data_(std::make_shared<const std::string>(data.string())) {}
+
+SharedBuffer::SharedBuffer(const SharedBuffer& other) : data_(other.data_) {}
+
+SharedBuffer::SharedBuffer(SharedBuffer&& other) MAIDSAFE_NOEXCEPT
+    : data_(std::move(other.data_)) {}
+
+SharedBuffer& SharedBuffer::operator=(SharedBuffer other) {
+  swap(*this, other);
+  return *this;
+}
+
+const std::string& SharedBuffer::string() const {
+  if (!data_)
+    BOOST_THROW_EXCEPTION(MakeError(CommonErrors::uninitialised));
+  return *data_;
+}
+
+bool SharedBuffer::IsInitialised() const { return static_cast<bool>(data_); }
+
+size_t SharedBuffer::size() const { return data_ ? data_->size() : 0; }
+
+void swap(SharedBuffer& lhs, SharedBuffer& rhs) MAIDSAFE_NOEXCEPT {
+  using std::swap;
+  swap(lhs.data_, rhs.data_);
+}
+
+bool operator==(const SharedBuffer& lhs, const SharedBuffer& rhs) {
+  if (!lhs.IsInitialised() || !rhs.IsInitialised())
+    return lhs.IsInitialised() == rhs.IsInitialised();
+  // Copies share their bytes, so avoid comparing the contents where possible.
+  return &lhs.string() == &rhs.string() || lhs.string() == rhs.string();
+}
+
+bool operator!=(const SharedBuffer& lhs, const SharedBuffer& rhs) { return !(lhs == rhs); }
+
+}  // namespace nfs
+
+}  // namespace maidsafe
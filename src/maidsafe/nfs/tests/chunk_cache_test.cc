@@ -0,0 +1,95 @@
+/*  Copyright 2013 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#include "maidsafe/nfs/client/chunk_cache.h"
+
+#include <vector>
+
+#include "maidsafe/common/test.h"
+#include "maidsafe/common/utils.h"
+#include "maidsafe/common/data_types/immutable_data.h"
+
+namespace maidsafe {
+
+namespace nfs {
+
+namespace test {
+
+namespace {
+
+std::vector<ImmutableData> MakeChunks(size_t count, size_t size) {
+  std::vector<ImmutableData> chunks;
+  for (size_t i(0); i < count; ++i)
+    chunks.emplace_back(NonEmptyString(RandomString(size)));
+  return chunks;
+}
+
+}  // unnamed namespace
+
+TEST(ChunkCacheTest, BEH_MemoryOnly) {
+  nfs_client::ChunkCache chunk_cache((MemoryUsage(300)));
+  auto chunks(MakeChunks(4, 100));
+  EXPECT_FALSE(chunk_cache.Get(chunks[0].name()));
+  for (size_t i(0); i < 3; ++i)
+    chunk_cache.Store(chunks[i]);
+
+  // Reading the first chunk makes the second the least recently used, so it's evicted next.
+  auto retrieved(chunk_cache.Get(chunks[0].name()));
+  ASSERT_TRUE(retrieved);
+  EXPECT_EQ(chunks[0].data(), retrieved->data());
+  chunk_cache.Store(chunks[3]);
+  EXPECT_TRUE(chunk_cache.Get(chunks[0].name()));
+  EXPECT_FALSE(chunk_cache.Get(chunks[1].name()));
+  EXPECT_TRUE(chunk_cache.Get(chunks[2].name()));
+  EXPECT_TRUE(chunk_cache.Get(chunks[3].name()));
+
+  // Too large to cache in memory, and there is no disk tier.
+  auto large_chunk(MakeChunks(1, 301).front());
+  chunk_cache.Store(large_chunk);
+  EXPECT_FALSE(chunk_cache.Get(large_chunk.name()));
+}
+
+TEST(ChunkCacheTest, BEH_MemoryAndDisk) {
+  maidsafe::test::TestPath test_path(maidsafe::test::CreateTestPath("MaidSafe_Test_ChunkCache"));
+  nfs_client::ChunkCache chunk_cache(MemoryUsage(200), *test_path / "cache", DiskUsage(200));
+  auto chunks(MakeChunks(5, 100));
+  for (const auto& chunk : chunks)
+    chunk_cache.Store(chunk);
+
+  // The two most recent chunks are in memory, the next two on disk and the oldest dropped.
+  EXPECT_FALSE(chunk_cache.Get(chunks[0].name()));
+  for (size_t i(1); i < chunks.size(); ++i) {
+    auto retrieved(chunk_cache.Get(chunks[i].name()));
+    ASSERT_TRUE(retrieved);
+    EXPECT_EQ(chunks[i].data(), retrieved->data());
+  }
+
+  // Too large for either tier.
+  auto large_chunk(MakeChunks(1, 201).front());
+  chunk_cache.Store(large_chunk);
+  EXPECT_FALSE(chunk_cache.Get(large_chunk.name()));
+  auto medium_chunk(MakeChunks(1, 150).front());
+  chunk_cache.Store(medium_chunk);
+  EXPECT_TRUE(chunk_cache.Get(medium_chunk.name()));
+}
+
+}  // namespace test
+
+}  // namespace nfs
+
+}  // namespace maidsafe
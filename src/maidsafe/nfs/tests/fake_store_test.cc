@@ -91,6 +91,13 @@ TEST_F(FakeStoreTest, BEH_SuccessfulStore) {
   ASSERT_TRUE(version1 == *itr++);
   ASSERT_TRUE(version0 == *itr);
 
+  retrieved_versions = fake_store_.GetVersionsSince(dir_name, version0).get();
+  ASSERT_TRUE(2U == retrieved_versions.size());
+  ASSERT_TRUE(version2 == retrieved_versions.front());
+  ASSERT_TRUE(version1 == retrieved_versions.back());
+  retrieved_versions = fake_store_.GetVersionsSince(dir_name, version2).get();
+  ASSERT_TRUE(retrieved_versions.empty());
+
   fake_store_.DeleteBranchUntilFork(dir_name, version2);
   retrieved_versions = fake_store_.GetVersions(dir_name).get();
   ASSERT_TRUE(retrieved_versions.empty());
@@ -0,0 +1,128 @@
+/*  Copyright 2014 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#include "maidsafe/nfs/client/get_handler.h"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "boost/thread/future.hpp"
+
+#include "maidsafe/common/asio_service.h"
+#include "maidsafe/common/test.h"
+#include "maidsafe/common/utils.h"
+#include "maidsafe/common/data_types/immutable_data.h"
+#include "maidsafe/common/data_types/mutable_data.h"
+#include "maidsafe/routing/timer.h"
+
+#include "maidsafe/nfs/client/messages.h"
+#include "maidsafe/nfs/vault/messages.h"
+
+namespace maidsafe {
+
+namespace nfs {
+
+namespace test {
+
+namespace {
+
+// Records the GetRequests sent by the GetHandler rather than sending them.
+class FakeGetDispatcher {
+ public:
+  FakeGetDispatcher() : mutex_(), requests_() {}
+
+  template <typename DataName>
+  void SendGetRequest(routing::TaskId task_id, const DataName& data_name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    requests_.push_back(std::make_pair(task_id, nfs_vault::DataName(data_name)));
+  }
+
+  std::vector<std::pair<routing::TaskId, nfs_vault::DataName>> requests() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return requests_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::pair<routing::TaskId, nfs_vault::DataName>> requests_;
+};
+
+}  // unnamed namespace
+
+TEST(GetHandlerTest, BEH_SameRawNameDifferentTypes) {
+  AsioService asio_service(2);
+  routing::Timer<nfs_client::DataNameAndContentOrReturnCode> get_timer(asio_service);
+  FakeGetDispatcher dispatcher;
+  nfs_client::GetHandler<FakeGetDispatcher> get_handler(asio_service, get_timer, dispatcher);
+
+  ImmutableData immutable_data(NonEmptyString(RandomString(100)));
+  MutableData mutable_data(MutableData::Name(immutable_data.name().value),
+                           NonEmptyString(RandomString(100)));
+  auto immutable_promise(std::make_shared<boost::promise<ImmutableData>>());
+  auto mutable_promise(std::make_shared<boost::promise<MutableData>>());
+  get_handler.Get(immutable_data.name(), immutable_promise, std::chrono::seconds(10));
+  get_handler.Get(mutable_data.name(), mutable_promise, std::chrono::seconds(10));
+
+  // The second Get mustn't join the first, since it's for a different type of data.
+  auto requests(dispatcher.requests());
+  ASSERT_EQ(2U, requests.size());
+  EXPECT_EQ(ImmutableData::Tag::kValue, requests[0].second.type);
+  EXPECT_EQ(MutableData::Tag::kValue, requests[1].second.type);
+
+  get_handler.AddResponse(requests[0].first,
+                          nfs_client::DataNameAndContentOrReturnCode(immutable_data));
+  get_handler.AddResponse(requests[1].first,
+                          nfs_client::DataNameAndContentOrReturnCode(mutable_data));
+  EXPECT_EQ(immutable_data.data(), immutable_promise->get_future().get().data());
+  EXPECT_EQ(mutable_data.data(), mutable_promise->get_future().get().data());
+}
+
+TEST(GetHandlerTest, BEH_JoinedGetOutlivesLeader) {
+  AsioService asio_service(2);
+  routing::Timer<nfs_client::DataNameAndContentOrReturnCode> get_timer(asio_service);
+  FakeGetDispatcher dispatcher;
+  nfs_client::GetHandler<FakeGetDispatcher> get_handler(asio_service, get_timer, dispatcher);
+
+  ImmutableData data(NonEmptyString(RandomString(100)));
+  auto leader_promise(std::make_shared<boost::promise<ImmutableData>>());
+  auto joiner_promise(std::make_shared<boost::promise<ImmutableData>>());
+  get_handler.Get(data.name(), leader_promise, std::chrono::seconds(1));
+  get_handler.Get(data.name(), joiner_promise, std::chrono::seconds(30));
+  ASSERT_EQ(1U, dispatcher.requests().size());
+
+  // Once the leader times out, the joined Get is re-issued rather than failing with it.
+  EXPECT_THROW(leader_promise->get_future().get(), std::exception);
+  auto deadline(std::chrono::steady_clock::now() + std::chrono::seconds(10));
+  while (dispatcher.requests().size() < 2 && std::chrono::steady_clock::now() < deadline)
+    Sleep(std::chrono::milliseconds(10));
+  auto requests(dispatcher.requests());
+  ASSERT_EQ(2U, requests.size());
+  EXPECT_EQ(requests[0].second, requests[1].second);
+
+  get_handler.AddResponse(requests[1].first, nfs_client::DataNameAndContentOrReturnCode(data));
+  EXPECT_EQ(data.data(), joiner_promise->get_future().get().data());
+}
+
+}  // namespace test
+
+}  // namespace nfs
+
+}  // namespace maidsafe
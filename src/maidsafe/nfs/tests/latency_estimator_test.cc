@@ -0,0 +1,111 @@
+/*  Copyright 2013 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#include "maidsafe/nfs/client/latency_estimator.h"
+
+#include <chrono>
+
+#include "maidsafe/common/test.h"
+
+namespace maidsafe {
+
+namespace nfs {
+
+namespace test {
+
+TEST(LatencyEstimatorTest, BEH_Percentile) {
+  nfs_client::LatencyEstimator estimator;
+  EXPECT_FALSE(estimator.Percentile(0.5, 0));
+  for (int i(1); i <= 10; ++i)
+    estimator.AddSample(std::chrono::milliseconds(i));
+  EXPECT_FALSE(estimator.Percentile(0.5, 11));
+  EXPECT_TRUE(std::chrono::milliseconds(1) == *estimator.Percentile(0.0, 10));
+  EXPECT_TRUE(std::chrono::milliseconds(5) == *estimator.Percentile(0.5, 10));
+  EXPECT_TRUE(std::chrono::milliseconds(10) == *estimator.Percentile(1.0, 10));
+
+  // Only the most recent kSampleCount samples are kept.
+  for (size_t i(0); i < nfs_client::LatencyEstimator::kSampleCount; ++i)
+    estimator.AddSample(std::chrono::seconds(1));
+  EXPECT_TRUE(std::chrono::seconds(1) == *estimator.Percentile(0.0, 1));
+}
+
+TEST(LatencyEstimatorTest, BEH_AdaptiveTimeout) {
+  typedef nfs_client::LatencyEstimator LatencyEstimator;
+  const LatencyEstimator::Duration kTimeout(std::chrono::seconds(120));
+  LatencyEstimator fast, slow;
+  EXPECT_FALSE(fast.RetransmissionTimeout(1));
+  for (size_t i(1); i < LatencyEstimator::kMinAdaptiveTimeoutSamples; ++i) {
+    fast.AddSample(std::chrono::seconds(2));
+    slow.AddSample(std::chrono::seconds(30));
+  }
+  // Too few samples to adapt.
+  EXPECT_TRUE(kTimeout == nfs_client::AdaptiveTimeout(fast, kTimeout));
+
+  fast.AddSample(std::chrono::seconds(2));
+  slow.AddSample(std::chrono::seconds(30));
+  EXPECT_TRUE(LatencyEstimator::kMinAdaptiveTimeout == nfs_client::AdaptiveTimeout(fast, kTimeout));
+  auto slow_timeout(nfs_client::AdaptiveTimeout(slow, kTimeout));
+  EXPECT_TRUE(slow_timeout > std::chrono::seconds(30));
+  EXPECT_TRUE(slow_timeout < kTimeout);
+  // The caller's timeout is never exceeded.
+  const LatencyEstimator::Duration kShortTimeout(std::chrono::seconds(5));
+  EXPECT_TRUE(kShortTimeout == nfs_client::AdaptiveTimeout(fast, kShortTimeout));
+  EXPECT_TRUE(kShortTimeout == nfs_client::AdaptiveTimeout(slow, kShortTimeout));
+}
+
+TEST(LatencyEstimatorTest, BEH_BackoffOnRisingLatency) {
+  typedef nfs_client::LatencyEstimator LatencyEstimator;
+  const LatencyEstimator::Duration kTimeout(std::chrono::seconds(120));
+  LatencyEstimator estimator;
+  for (size_t i(0); i < LatencyEstimator::kMinAdaptiveTimeoutSamples; ++i)
+    estimator.AddSample(std::chrono::seconds(2));
+  auto timeout(nfs_client::AdaptiveTimeout(estimator, kTimeout));
+  EXPECT_TRUE(LatencyEstimator::kMinAdaptiveTimeout == timeout);
+
+  // Latency rises beyond the adaptive timeout, so operations time out, each doubling the timeout,
+  // until it's long enough for an operation to succeed.
+  const LatencyEstimator::Duration kLatency(std::chrono::seconds(50));
+  unsigned timeouts(0);
+  while (timeout < kLatency) {
+    estimator.AddTimeout();
+    ++timeouts;
+    auto next_timeout(nfs_client::AdaptiveTimeout(estimator, kTimeout));
+    EXPECT_TRUE(std::min(timeout * 2, kTimeout) == next_timeout);
+    timeout = next_timeout;
+  }
+  EXPECT_EQ(3U, timeouts);
+  EXPECT_EQ(timeouts, estimator.TimeoutCount());
+
+  // The caller's timeout is never exceeded.
+  for (int i(0); i < 10; ++i)
+    estimator.AddTimeout();
+  EXPECT_TRUE(kTimeout == nfs_client::AdaptiveTimeout(estimator, kTimeout));
+
+  // The next success resets the backoff, leaving the timeout to follow the raised estimate.
+  estimator.AddSample(kLatency);
+  EXPECT_EQ(0U, estimator.TimeoutCount());
+  timeout = nfs_client::AdaptiveTimeout(estimator, kTimeout);
+  EXPECT_TRUE(timeout > kLatency);
+  EXPECT_TRUE(timeout < kTimeout);
+}
+
+}  // namespace test
+
+}  // namespace nfs
+
+}  // namespace maidsafe
@@ -0,0 +1,88 @@
+/*  Copyright 2014 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#include "maidsafe/nfs/lazy_contents.h"
+
+#include <string>
+
+#include "maidsafe/common/error.h"
+#include "maidsafe/common/test.h"
+
+namespace maidsafe {
+
+namespace nfs {
+
+namespace test {
+
+namespace {
+
+// Counts how often it is parsed, and serialises with a prefix so that re-serialised contents can be
+// told apart from the received bytes.
+struct ParsedContents {
+  explicit ParsedContents(const std::string& serialised_copy) : value(serialised_copy) {
+    ++parse_count;
+  }
+  ParsedContents(const ParsedContents& other) : value(other.value) {}
+  std::string Serialise() const { return "serialised " + value; }
+  std::string value;
+  static int parse_count;
+};
+
+int ParsedContents::parse_count(0);
+
+}  // unnamed namespace
+
+TEST(LazyContentsTest, BEH_ParseOnDemand) {
+  ParsedContents::parse_count = 0;
+  const LazyContents<ParsedContents> contents(std::string("received"));
+  EXPECT_TRUE(static_cast<bool>(contents));
+  EXPECT_EQ(0, ParsedContents::parse_count);
+  EXPECT_EQ("received", contents.Serialise());
+  EXPECT_EQ(0, ParsedContents::parse_count);
+
+  EXPECT_EQ("received", contents->value);
+  EXPECT_EQ(1, ParsedContents::parse_count);
+  const LazyContents<ParsedContents> copy(contents);
+  EXPECT_EQ("received", (*copy).value);
+  EXPECT_EQ(1, ParsedContents::parse_count);
+  // Read-only access leaves the received bytes in use.
+  EXPECT_EQ("received", copy.Serialise());
+}
+
+TEST(LazyContentsTest, BEH_SerialiseAfterChange) {
+  LazyContents<ParsedContents> contents(std::string("received"));
+  EXPECT_EQ("received", contents.Serialise());
+  contents->value = "changed";
+  EXPECT_EQ("serialised changed", contents.Serialise());
+
+  const LazyContents<ParsedContents> constructed(ParsedContents("constructed"));
+  EXPECT_EQ("serialised constructed", constructed.Serialise());
+}
+
+TEST(LazyContentsTest, BEH_Empty) {
+  LazyContents<ParsedContents> contents;
+  EXPECT_FALSE(static_cast<bool>(contents));
+  EXPECT_EQ(nullptr, contents.get());
+  EXPECT_THROW(contents.Serialise(), maidsafe_error);
+}
+
+}  // namespace test
+
+}  // namespace nfs
+
+}  // namespace maidsafe
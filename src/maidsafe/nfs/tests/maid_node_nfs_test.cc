@@ -18,6 +18,11 @@
 
 #include "maidsafe/nfs/tests/maid_node_nfs_test.h"
 
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <vector>
+
 namespace maidsafe {
 
 namespace nfs {
@@ -82,6 +87,97 @@ TEST_F(MaidNodeNfsTest, FUNC_MultipleSequentialPuts) {
   LOG(kVerbose) << "Multiple sequential puts is finished successfully";
 }
 
+TEST_F(MaidNodeNfsTest, FUNC_PutMany) {
+  const size_t kIterations(10);
+  GenerateChunks(kIterations);
+  AddClient();
+  auto put_futures(clients_.back()->PutMany(chunks_));
+  ASSERT_EQ(chunks_.size(), put_futures.size());
+  for (size_t index(0); index < put_futures.size(); ++index) {
+    EXPECT_NO_THROW(put_futures[index].get())
+        << "Store failure " << DebugId(NodeId(chunks_[index].name()->string()));
+  }
+
+  std::vector<boost::future<ImmutableData>> get_futures;
+  for (const auto& chunk : chunks_) {
+    get_futures.emplace_back(clients_.back()->Get<ImmutableData::Name>(
+        chunk.name(), std::chrono::seconds(kIterations * 36)));
+  }
+  CompareGetResult(chunks_, get_futures);
+}
+
+TEST_F(MaidNodeNfsTest, FUNC_PutPipelined) {
+  const size_t kIterations(20), kMaxInFlight(4);
+  GenerateChunks(kIterations);
+  AddClient();
+  std::mutex mutex;
+  std::vector<ImmutableData::Name> stored;
+  auto put_future(clients_.back()->PutPipelined(
+      std::begin(chunks_), std::end(chunks_), kMaxInFlight,
+      [&](const ImmutableData::Name& name, const maidsafe_error& result) {
+        EXPECT_EQ(make_error_code(CommonErrors::success), result.code());
+        std::lock_guard<std::mutex> lock(mutex);
+        stored.push_back(name);
+      }));
+  EXPECT_NO_THROW(put_future.get());
+  EXPECT_EQ(chunks_.size(), stored.size());
+
+  std::vector<boost::future<ImmutableData>> get_futures;
+  for (const auto& chunk : chunks_) {
+    get_futures.emplace_back(clients_.back()->Get<ImmutableData::Name>(
+        chunk.name(), std::chrono::seconds(kIterations * 36)));
+  }
+  CompareGetResult(chunks_, get_futures);
+}
+
+TEST_F(MaidNodeNfsTest, FUNC_PutPipelinedWindow) {
+  const size_t kIterations(20), kMaxInFlight(3);
+  GenerateChunks(kIterations);
+  AddClient();
+  // 'on_result' is called before a completed Put leaves the window, so 'issued' - 'completed' never
+  // understates the number in flight.
+  std::mutex mutex;
+  size_t issued(0), completed(0), peak_in_flight(0), calls(0);
+  std::function<boost::optional<ImmutableData>()> next_chunk([&]() {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++calls;
+    EXPECT_LT(issued - completed, kMaxInFlight) << "next_chunk called with the window full";
+    if (issued == chunks_.size())
+      return boost::optional<ImmutableData>();
+    ++issued;
+    peak_in_flight = std::max(peak_in_flight, issued - completed);
+    return boost::optional<ImmutableData>(chunks_[issued - 1]);
+  });
+  auto put_future(clients_.back()->PutPipelined(
+      next_chunk, kMaxInFlight, [&](const ImmutableData::Name&, const maidsafe_error& result) {
+        EXPECT_EQ(make_error_code(CommonErrors::success), result.code());
+        std::lock_guard<std::mutex> lock(mutex);
+        ++completed;
+      }));
+  EXPECT_NO_THROW(put_future.get());
+  std::lock_guard<std::mutex> lock(mutex);
+  EXPECT_EQ(chunks_.size(), completed);
+  EXPECT_LE(peak_in_flight, kMaxInFlight);
+  // Once exhausted, 'next_chunk' isn't called again.
+  EXPECT_EQ(chunks_.size() + 1, calls);
+}
+
+TEST_F(MaidNodeNfsTest, FUNC_ConcurrentGetsOfSameChunk) {
+  const size_t kGets(10);
+  GenerateChunks(1);
+  AddClient();
+  auto put_future(clients_.back()->Put(chunks_.front()));
+  EXPECT_NO_THROW(put_future.get());
+
+  std::vector<ImmutableData> chunks(kGets, chunks_.front());
+  std::vector<boost::future<ImmutableData>> get_futures;
+  for (size_t i(0); i < kGets; ++i) {
+    get_futures.emplace_back(clients_.back()->Get<ImmutableData::Name>(
+        chunks_.front().name(), std::chrono::seconds(36)));
+  }
+  CompareGetResult(chunks, get_futures);
+}
+
 TEST_F(MaidNodeNfsTest, FUNC_MultipleParallelPuts) {
   routing::Parameters::caching = false;
   LOG(kVerbose) << "put 10 chunks with 1 clients";
@@ -190,6 +286,43 @@ TEST_F(MaidNodeNfsTest, FUNC_PopulateSingleBranchTree) {
   }
 }
 
+TEST_F(MaidNodeNfsTest, FUNC_GetBranchPages) {
+  ImmutableData chunk(NonEmptyString(RandomAlphaNumericString(1024)));
+  const size_t max_versions(20), max_branches(1);
+  const uint32_t kPageSize(6);
+  GenerateChunks(max_versions);
+  StructuredDataVersions::VersionName v_ori(0, chunks_.front().name());
+  AddClient();
+  auto create_version_future(clients_.back()->CreateVersionTree(chunk.name(), v_ori,
+      static_cast<uint32_t>(max_versions), static_cast<uint32_t>(max_branches)));
+  EXPECT_NO_THROW(create_version_future.get()) << "failure to create version";
+  for (size_t index(1); index < max_versions; ++index) {
+    StructuredDataVersions::VersionName v_old(index - 1, chunks_[index - 1].name());
+    StructuredDataVersions::VersionName v_new(index, chunks_[index].name());
+    auto put_version_future(clients_.back()->PutVersion(chunk.name(), v_old, v_new));
+    EXPECT_NO_THROW(put_version_future.get()) << "failure to put version " << index;
+  }
+
+  std::vector<StructuredDataVersions::VersionName> versions;
+  boost::optional<StructuredDataVersions::VersionName> page_start(
+      StructuredDataVersions::VersionName(max_versions - 1, chunks_.back().name()));
+  try {
+    while (page_start) {
+      auto page(clients_.back()->GetBranch(chunk.name(), *page_start, kPageSize).get());
+      EXPECT_LE(page.versions.size(), kPageSize);
+      versions.insert(std::end(versions), std::begin(page.versions), std::end(page.versions));
+      page_start = page.next_page_start;
+    }
+  } catch (const maidsafe_error& error) {
+    GTEST_FAIL() << "Failed to retrieve branch: " << boost::diagnostic_information(error);
+  }
+  ASSERT_EQ(versions.size(), max_versions);
+  for (size_t index(0); index < versions.size(); ++index) {
+    EXPECT_EQ(versions[index].index, max_versions - index - 1);
+    EXPECT_EQ(versions[index].id, chunks_[max_versions - index - 1].name());
+  }
+}
+
 TEST_F(MaidNodeNfsTest, FUNC_PopulateMultipleBranchTree) {
   VersionTreeTest(5, 4, 20);
   VersionTreeTest(100, 10, 60);
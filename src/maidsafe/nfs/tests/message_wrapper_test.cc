@@ -18,7 +18,12 @@
 
 #include "maidsafe/nfs/message_wrapper.h"
 
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "boost/variant/static_visitor.hpp"
 #include "boost/variant/variant.hpp"
@@ -165,6 +170,50 @@ TEST(MessageWrapperTest, BEH_CheckVariant) {
   EXPECT_THROW(data_manager_service.HandleMessage(tuple_del), maidsafe_error);
 }
 
+TEST(MessageWrapperTest, BEH_MessageIds) {
+  const size_t kThreadCount(8), kIdsPerThread(5000);
+  std::vector<std::future<std::vector<MessageId>>> futures;
+  for (size_t i(0); i != kThreadCount; ++i) {
+    futures.emplace_back(std::async(std::launch::async, [] {
+      std::vector<MessageId> ids;
+      for (size_t j(0); j != kIdsPerThread; ++j)
+        ids.push_back(detail::GetNewMessageId());
+      return ids;
+    }));
+  }
+  std::set<int32_t> unique_ids;
+  for (auto& future : futures) {
+    for (const auto& id : future.get())
+      EXPECT_TRUE(unique_ids.insert(id.data).second);
+  }
+  EXPECT_EQ(kThreadCount * kIdsPerThread, unique_ids.size());
+
+  // Ids across the whole int32 range, including negative ones, survive a round trip.
+  ImmutableData data(NonEmptyString("data"));
+  for (int32_t id : {std::numeric_limits<int32_t>::min(), -1, 0,
+                     std::numeric_limits<int32_t>::max()}) {
+    GetRequest get(MessageId(id), GetRequest::Contents(data.name()));
+    EXPECT_EQ(id, std::get<3>(ParseMessageWrapper(get.Serialise())).data);
+  }
+}
+
+TEST(MessageWrapperTest, BEH_SerialiseWithCachedHeader) {
+  ImmutableData data(NonEmptyString(RandomString(300)));
+  PutRequest put(MessageId(-1), PutRequest::Contents(nfs_vault::DataNameAndContent(data)));
+  DeleteRequest del(DeleteRequest::Contents(data.name()));
+  EXPECT_EQ(detail::SerialiseMessageWrapper(std::make_tuple(
+                PutRequest::kAction, detail::SourceTaggedValue(PutRequest::SourcePersona::value),
+                detail::DestinationTaggedValue(PutRequest::DestinationPersona::value), put.id,
+                put.contents->Serialise())),
+            put.Serialise());
+  EXPECT_EQ(detail::SerialiseMessageWrapper(std::make_tuple(
+                DeleteRequest::kAction,
+                detail::SourceTaggedValue(DeleteRequest::SourcePersona::value),
+                detail::DestinationTaggedValue(DeleteRequest::DestinationPersona::value), del.id,
+                del.contents->Serialise())),
+            del.Serialise());
+}
+
 /*
  TEST_F(MessageWrapperTest, BEH_SerialiseThenParse) {
   auto serialised_message(message_.Serialise());
@@ -0,0 +1,72 @@
+/*  Copyright 2013 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#include "maidsafe/nfs/utils.h"
+
+#include <vector>
+
+#include "maidsafe/common/error.h"
+#include "maidsafe/common/test.h"
+#include "maidsafe/routing/parameters.h"
+
+#include "maidsafe/nfs/client/messages.h"
+
+namespace maidsafe {
+
+namespace nfs {
+
+namespace test {
+
+TEST(OpDataTest, BEH_Success) {
+  std::vector<nfs_client::ReturnCode> results;
+  OpData<nfs_client::ReturnCode> op_data(
+      2, [&](nfs_client::ReturnCode result) { results.push_back(std::move(result)); });
+  op_data.HandleResponseContents(nfs_client::ReturnCode(CommonErrors::no_such_element));
+  op_data.HandleResponseContents(nfs_client::ReturnCode(CommonErrors::success));
+  EXPECT_TRUE(results.empty());
+  op_data.HandleResponseContents(nfs_client::ReturnCode(CommonErrors::success));
+  ASSERT_EQ(1U, results.size());
+  EXPECT_TRUE(IsSuccess(results.front()));
+
+  // Late responses are ignored.
+  op_data.HandleResponseContents(nfs_client::ReturnCode(CommonErrors::invalid_parameter));
+  EXPECT_EQ(1U, results.size());
+}
+
+TEST(OpDataTest, BEH_MostFrequentFailure) {
+  std::vector<nfs_client::ReturnCode> results;
+  OpData<nfs_client::ReturnCode> op_data(
+      routing::Parameters::group_size,
+      [&](nfs_client::ReturnCode result) { results.push_back(std::move(result)); });
+  op_data.HandleResponseContents(nfs_client::ReturnCode(CommonErrors::invalid_parameter));
+  // The operation fails once more than half of the group has responded.
+  for (unsigned i(1); i < routing::Parameters::group_size / 2U; ++i) {
+    EXPECT_TRUE(results.empty());
+    op_data.HandleResponseContents(nfs_client::ReturnCode(CommonErrors::no_such_element));
+  }
+  EXPECT_TRUE(results.empty());
+  op_data.HandleResponseContents(nfs_client::ReturnCode(CommonErrors::no_such_element));
+  ASSERT_EQ(1U, results.size());
+  EXPECT_EQ(make_error_code(CommonErrors::no_such_element), ErrorCode(results.front()));
+}
+
+}  // namespace test
+
+}  // namespace nfs
+
+}  // namespace maidsafe
@@ -0,0 +1,74 @@
+/*  Copyright 2014 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#include "maidsafe/nfs/client/messages.h"
+
+#include <string>
+
+#include "maidsafe/common/error.h"
+#include "maidsafe/common/test.h"
+
+#include "maidsafe/nfs/tests/baseline_messages.pb.h"
+
+namespace maidsafe {
+
+namespace nfs {
+
+namespace test {
+
+TEST(ReturnCodeTest, BEH_ReadableByOlderPeers) {
+  nfs_client::ReturnCode return_code(CommonErrors::no_such_element);
+  protobuf::BaselineReturnCode baseline;
+  ASSERT_TRUE(baseline.ParseFromString(return_code.Serialise()));
+  EXPECT_EQ(return_code.value.code().value(), baseline.error_value());
+  EXPECT_EQ(std::string(return_code.value.code().category().name()),
+            baseline.error_category_name());
+}
+
+TEST(ReturnCodeTest, BEH_ParseFromOlderPeers) {
+  protobuf::BaselineReturnCode baseline;
+  auto error(MakeError(NfsErrors::failed_to_get_data));
+  baseline.set_error_value(error.code().value());
+  baseline.set_error_category_name(error.code().category().name());
+  nfs_client::ReturnCode return_code(baseline.SerializeAsString());
+  EXPECT_EQ(error.code(), return_code.value.code());
+}
+
+TEST(ReturnCodeTest, BEH_SerialiseThenParse) {
+  nfs_client::ReturnCode return_code(CommonErrors::success);
+  nfs_client::ReturnCode parsed(return_code.Serialise());
+  EXPECT_EQ(return_code, parsed);
+}
+
+TEST(ReturnCodeTest, BEH_OmitCategoryNames) {
+  nfs_client::ReturnCode return_code(NfsErrors::failed_to_get_data);
+  auto with_name(return_code.Serialise());
+  nfs_client::SetWriteErrorCategoryNames(false);
+  auto without_name(return_code.Serialise());
+  nfs_client::SetWriteErrorCategoryNames(true);
+  EXPECT_LT(without_name.size(), with_name.size());
+  protobuf::BaselineReturnCode baseline;
+  EXPECT_FALSE(baseline.ParseFromString(without_name));
+  EXPECT_EQ(return_code, nfs_client::ReturnCode(without_name));
+}
+
+}  // namespace test
+
+}  // namespace nfs
+
+}  // namespace maidsafe
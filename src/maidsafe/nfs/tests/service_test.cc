@@ -52,7 +52,7 @@ TEST_F(ServiceTest, BEH_All) {
   typedef nfs_client::DataGetterService::GetResponse GetResponse;
   nfs_client::DataGetterDispatcher dispatcher(routing);
   routing::Timer<typename GetResponse::Contents> get_timer(asio_service);
-  nfs_client::GetHandler<nfs_client::DataGetterDispatcher> get_handler(get_timer,
+  nfs_client::GetHandler<nfs_client::DataGetterDispatcher> get_handler(asio_service, get_timer,
                                                                        dispatcher);
   routing::Timer<typename nfs_client::DataGetterService::GetVersionsResponse::Contents>
       get_versions_timer(asio_service);
@@ -92,6 +92,41 @@ TEST_F(ServiceTest, BEH_All) {
   EXPECT_EQ(immutable_data.data(), retrieved.data());
 }
 
+TEST_F(ServiceTest, BEH_UnhandledMessage) {
+  passport::Anmaid anmaid;
+  passport::Maid maid(anmaid);
+  routing::Routing routing(maid);
+  AsioService asio_service(2);
+  nfs_client::DataGetterDispatcher dispatcher(routing);
+  routing::Timer<typename nfs_client::DataGetterService::GetResponse::Contents> get_timer(
+      asio_service);
+  nfs_client::GetHandler<nfs_client::DataGetterDispatcher> get_handler(asio_service, get_timer,
+                                                                       dispatcher);
+  routing::Timer<typename nfs_client::DataGetterService::GetVersionsResponse::Contents>
+      get_versions_timer(asio_service);
+  routing::Timer<typename nfs_client::DataGetterService::GetBranchResponse::Contents>
+      get_branch_timer(asio_service);
+  Service<nfs_client::DataGetterService> service(
+      std::move(std::unique_ptr<nfs_client::DataGetterService>(
+          new nfs_client::DataGetterService(
+              routing, get_handler, get_versions_timer, get_branch_timer))));
+
+  // Same routing Sender and Receiver types as a DataGetter GetResponse, but addressed to MaidNode.
+  typedef GetResponseFromDataManagerToMaidNode MaidNodeGetResponse;
+  ImmutableData immutable_data(NonEmptyString(RandomString(10)));
+  MaidNodeGetResponse get_response(MessageId(RandomInt32()),
+                                   MaidNodeGetResponse::Contents(immutable_data));
+  MaidNodeGetResponse::Sender sender((routing::GroupId(NodeId(RandomString(NodeId::kSize)))),
+                                     (routing::SingleId(NodeId(RandomString(NodeId::kSize)))));
+  MaidNodeGetResponse::Receiver receiver(routing.kNodeId());
+
+  auto response_tuple(ParseMessageWrapper(get_response.Serialise()));
+  EXPECT_THROW(service.HandleMessage(response_tuple, sender, receiver), maidsafe_error);
+
+  std::get<0>(response_tuple) = static_cast<MessageAction>(-1);
+  EXPECT_THROW(service.HandleMessage(response_tuple, sender, receiver), maidsafe_error);
+}
+
 }  // namespace test
 
 }  // namespace nfs
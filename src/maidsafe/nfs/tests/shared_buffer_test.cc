@@ -0,0 +1,82 @@
+/*  Copyright 2013 MaidSafe.net limited
+
+    This MaidSafe Software is licensed to you under (1) the MaidSafe.net Commercial License,
+    version 1.0 or later, or (2) The General Public License (GPL), version 3, depending on which
+    licence you accepted on initial access to the Software (the "Licences").
+
+    By contributing code to the MaidSafe Software, or to this project generally, you agree to be
+    bound by the terms of the MaidSafe Contributor Agreement, version 1.0, found in the root
+    directory of this project at LICENSE, COPYING and CONTRIBUTOR respectively and also
+    available at: http://www.maidsafe.net/licenses
+
+    Unless required by applicable law or agreed to in writing, the MaidSafe Software distributed
+    under the GPL Licence is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS
+    OF ANY KIND, either express or implied.
+
+    See the Licences for the specific language governing permissions and limitations relating to
+    use of the MaidSafe Software.                                                                 */
+
+#include "maidsafe/nfs/shared_buffer.h"
+
+#include <string>
+
+#include "maidsafe/common/error.h"
+#include "maidsafe/common/test.h"
+#include "maidsafe/common/utils.h"
+#include "maidsafe/common/data_types/immutable_data.h"
+
+#include "maidsafe/nfs/vault/messages.h"
+
+namespace maidsafe {
+
+namespace nfs {
+
+namespace test {
+
+TEST(SharedBufferTest, BEH_Constructor) {
+  SharedBuffer uninitialised;
+  EXPECT_FALSE(uninitialised.IsInitialised());
+  EXPECT_EQ(0U, uninitialised.size());
+  EXPECT_THROW(uninitialised.string(), maidsafe_error);
+
+  std::string data(RandomString(1024));
+  SharedBuffer buffer(data);
+  EXPECT_TRUE(buffer.IsInitialised());
+  EXPECT_EQ(data, buffer.string());
+  EXPECT_EQ(data.size(), buffer.size());
+  EXPECT_EQ(data, SharedBuffer(NonEmptyString(data)).string());
+  EXPECT_NE(uninitialised, buffer);
+}
+
+TEST(SharedBufferTest, BEH_CopiesShareData) {
+  SharedBuffer buffer(RandomString(1024));
+  SharedBuffer copy(buffer);
+  EXPECT_EQ(&buffer.string(), &copy.string());
+  EXPECT_EQ(buffer, copy);
+
+  SharedBuffer assigned;
+  assigned = copy;
+  EXPECT_EQ(&buffer.string(), &assigned.string());
+
+  nfs_vault::Content content(buffer);
+  nfs_vault::Content content_copy(content);
+  EXPECT_EQ(&buffer.string(), &content_copy.data.string());
+
+  SharedBuffer other(buffer.string());
+  EXPECT_NE(&buffer.string(), &other.string());
+  EXPECT_EQ(buffer, other);
+}
+
+TEST(SharedBufferTest, BEH_DataNameAndContentSerialiseThenParse) {
+  ImmutableData data(NonEmptyString(RandomString(1024)));
+  nfs_vault::DataNameAndContent data_name_and_content(data);
+  nfs_vault::DataNameAndContent parsed(data_name_and_content.Serialise());
+  EXPECT_EQ(data_name_and_content, parsed);
+  EXPECT_EQ(data.Serialise().data.string(), parsed.content.string());
+}
+
+}  // namespace test
+
+}  // namespace nfs
+
+}  // namespace maidsafe
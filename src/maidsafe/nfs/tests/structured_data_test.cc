@@ -18,7 +18,9 @@
 
 #include "maidsafe/nfs/client/structured_data.h"
 
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "maidsafe/common/log.h"
@@ -26,6 +28,8 @@
 #include "maidsafe/common/test.h"
 #include "maidsafe/common/utils.h"
 
+#include "maidsafe/nfs/tests/baseline_messages.pb.h"
+
 namespace maidsafe {
 
 namespace nfs {
@@ -54,7 +58,7 @@ TEST_F(StructuredDataTest, BEH_Constructor) {
   }
 
   nfs_client::StructuredData structured_data(versions);
-  auto versions_fetched(structured_data.versions);
+  auto versions_fetched(structured_data.versions());
   EXPECT_EQ(num_of_versions + 1, versions_fetched.size());
   for (uint32_t i(0); i < (num_of_versions + 1); ++i) {
     EXPECT_EQ(versions[i].id, versions_fetched[i].id);
@@ -84,7 +88,7 @@ TEST_F(StructuredDataTest, BEH_Serialise) {
 
   nfs_client::StructuredData structured_data_ori(versions);
   nfs_client::StructuredData structured_data_serialise(structured_data_ori.Serialise());
-  auto versions_parsed(structured_data_serialise.versions);
+  auto versions_parsed(structured_data_serialise.versions());
   EXPECT_EQ(num_of_versions, versions_parsed.size());
   for (uint32_t i(0); i < num_of_versions; ++i) {
     EXPECT_EQ(versions[i].id, versions_parsed[i].id);
@@ -92,6 +96,106 @@ TEST_F(StructuredDataTest, BEH_Serialise) {
   }
 }
 
+TEST_F(StructuredDataTest, BEH_SerialiseBranch) {
+  // A branch as returned by GetBranch: indexes descending from the tip.
+  std::vector<StructuredDataVersions::VersionName> versions;
+  const uint64_t kTipIndex(RandomUint32() % 4096 + 2000);
+  for (uint64_t index(kTipIndex); index != 0; --index) {
+    versions.emplace_back(index, ImmutableData::Name(Identity(RandomString(64))));
+  }
+
+  nfs_client::StructuredData structured_data_ori(versions);
+  std::string serialised(structured_data_ori.Serialise());
+  nfs_client::StructuredData structured_data_parsed(serialised);
+  auto versions_parsed(structured_data_parsed.versions());
+  ASSERT_EQ(versions.size(), versions_parsed.size());
+  for (size_t i(0); i < versions.size(); ++i) {
+    EXPECT_EQ(versions[i].id, versions_parsed[i].id);
+    EXPECT_EQ(versions[i].index, versions_parsed[i].index);
+  }
+  EXPECT_EQ(serialised, structured_data_parsed.Serialise());
+
+  nfs_client::StructuredData empty_parsed(nfs_client::StructuredData().Serialise());
+  EXPECT_TRUE(empty_parsed.versions().empty());
+}
+
+TEST_F(StructuredDataTest, BEH_ReadableByOlderPeers) {
+  std::vector<StructuredDataVersions::VersionName> versions;
+  for (uint64_t index(100); index != 0; --index)
+    versions.emplace_back(index, ImmutableData::Name(Identity(RandomString(64))));
+
+  protobuf::BaselineStructuredData baseline;
+  ASSERT_TRUE(baseline.ParseFromString(nfs_client::StructuredData(versions).Serialise()));
+  ASSERT_EQ(versions.size(), static_cast<size_t>(baseline.serialised_versions_size()));
+  for (size_t i(0); i < versions.size(); ++i) {
+    EXPECT_EQ(versions[i], StructuredDataVersions::VersionName(
+                               baseline.serialised_versions(static_cast<int>(i))));
+  }
+
+  protobuf::BaselineStructuredData from_older_peer;
+  for (const auto& version : versions)
+    from_older_peer.add_serialised_versions(version.Serialise());
+  nfs_client::StructuredData parsed(from_older_peer.SerializeAsString());
+  EXPECT_EQ(versions, parsed.versions());
+}
+
+TEST_F(StructuredDataTest, BEH_SerialisePacked) {
+  std::vector<StructuredDataVersions::VersionName> versions;
+  for (uint64_t index(100); index != 0; --index)
+    versions.emplace_back(index, ImmutableData::Name(Identity(RandomString(64))));
+  nfs_client::StructuredData structured_data(versions);
+
+  std::string unpacked(structured_data.Serialise());
+  nfs_client::SetWritePackedVersions(true);
+  std::string packed(structured_data.Serialise());
+  nfs_client::SetWritePackedVersions(false);
+  EXPECT_LT(packed.size(), unpacked.size());
+
+  // Only one encoding is written.
+  protobuf::BaselineStructuredData baseline;
+  ASSERT_TRUE(baseline.ParseFromString(packed));
+  EXPECT_EQ(0, baseline.serialised_versions_size());
+
+  EXPECT_EQ(versions, nfs_client::StructuredData(packed).versions());
+  EXPECT_EQ(versions, nfs_client::StructuredData(unpacked).versions());
+}
+
+TEST_F(StructuredDataTest, BEH_Equality) {
+  std::vector<StructuredDataVersions::VersionName> versions;
+  uint32_t num_of_versions(RandomUint32() % 256 + 10);
+  for (uint32_t i(0); i < num_of_versions; ++i) {
+    versions.emplace_back(RandomUint32(), ImmutableData::Name(Identity(RandomString(64))));
+  }
+
+  nfs_client::StructuredData structured_data(versions);
+  nfs_client::StructuredData structured_data_parsed(structured_data.Serialise());
+  EXPECT_EQ(structured_data.digest(), structured_data_parsed.digest());
+  EXPECT_TRUE(structured_data == structured_data_parsed);
+
+  std::reverse(std::begin(versions), std::end(versions));
+  nfs_client::StructuredData structured_data_reordered(versions);
+  EXPECT_EQ(structured_data.digest(), structured_data_reordered.digest());
+  EXPECT_TRUE(structured_data == structured_data_reordered);
+
+  // Modifying the versions invalidates the cached digest.
+  nfs_client::StructuredData structured_data_modified_later(structured_data_reordered);
+  auto original_front(structured_data_modified_later.versions().front());
+  structured_data_modified_later.mutable_versions().front() = StructuredDataVersions::VersionName(
+      original_front.index, ImmutableData::Name(Identity(RandomString(64))));
+  EXPECT_FALSE(structured_data == structured_data_modified_later);
+  structured_data_modified_later.mutable_versions().front() = original_front;
+  EXPECT_EQ(structured_data.digest(), structured_data_modified_later.digest());
+  EXPECT_TRUE(structured_data == structured_data_modified_later);
+  structured_data_modified_later.mutable_versions().pop_back();
+  EXPECT_FALSE(structured_data == structured_data_modified_later);
+
+  versions.back() = StructuredDataVersions::VersionName(
+      versions.back().index, ImmutableData::Name(Identity(RandomString(64))));
+  nfs_client::StructuredData structured_data_modified(versions);
+  EXPECT_FALSE(structured_data == structured_data_modified);
+  EXPECT_FALSE(structured_data == nfs_client::StructuredData());
+}
+
 }  // namespace test
 
 }  // namespace nfs
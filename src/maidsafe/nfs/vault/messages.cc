@@ -27,6 +27,36 @@ namespace maidsafe {
 
 namespace nfs_vault {
 
+namespace {
+
+DataName ParseDataName(const protobuf::DataName& proto_data_name) {
+  return DataName(static_cast<DataTagValue>(proto_data_name.type()),
+                  Identity(proto_data_name.raw_name()));
+}
+
+void SetDataName(const DataName& data_name, protobuf::DataName* proto_data_name) {
+  proto_data_name->set_type(static_cast<uint32_t>(data_name.type));
+  proto_data_name->set_raw_name(data_name.raw_name.string());
+}
+
+// Moves the content out of 'proto_data_name_and_content'.
+DataNameAndContent ParseDataNameAndContent(
+    protobuf::DataNameAndContent& proto_data_name_and_content) {
+  if (proto_data_name_and_content.content().empty())
+    BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
+  return DataNameAndContent(
+      ParseDataName(proto_data_name_and_content.name()),
+      nfs::SharedBuffer(std::move(*proto_data_name_and_content.mutable_content())));
+}
+
+void SetDataNameAndContent(const DataNameAndContent& data_name_and_content,
+                           protobuf::DataNameAndContent* proto_data_name_and_content) {
+  SetDataName(data_name_and_content.name, proto_data_name_and_content->mutable_name());
+  proto_data_name_and_content->set_content(data_name_and_content.content.string());
+}
+
+}  // unnamed namespace
+
 // ========================== Empty ================================================================
 
 bool operator==(const Empty& /*lhs*/, const Empty& /*rhs*/) { return true; }
@@ -39,7 +69,7 @@ AvailableSize::AvailableSize(uint64_t size) : available_size(size) {}
 
 AvailableSize::AvailableSize(const AvailableSize& other) : available_size(other.available_size) {}
 
-AvailableSize::AvailableSize(AvailableSize&& other)
+AvailableSize::AvailableSize(AvailableSize&& other) MAIDSAFE_NOEXCEPT
     : available_size(std::move(other.available_size)) {}
 
 AvailableSize& AvailableSize::operator=(AvailableSize other) {
@@ -76,7 +106,7 @@ DiffSize::DiffSize(int64_t size) : diff_size(size) {}
 
 DiffSize::DiffSize(const DiffSize& other) : diff_size(other.diff_size) {}
 
-DiffSize::DiffSize(DiffSize&& other)
+DiffSize::DiffSize(DiffSize&& other) MAIDSAFE_NOEXCEPT
     : diff_size(std::move(other.diff_size)) {}
 
 DiffSize& DiffSize::operator=(DiffSize other) {
@@ -115,7 +145,7 @@ DataName::DataName() : type(DataTagValue::kAnmaidValue), raw_name() {}
 
 DataName::DataName(const DataName& other) : type(other.type), raw_name(other.raw_name) {}
 
-DataName::DataName(DataName&& other)
+DataName::DataName(DataName&& other) MAIDSAFE_NOEXCEPT
     : type(std::move(other.type)), raw_name(std::move(other.raw_name)) {}
 
 DataName& DataName::operator=(DataName other) {
@@ -161,7 +191,7 @@ DataNames::DataNames() : data_names_() {}
 
 DataNames::DataNames(const DataNames& other) : data_names_(other.data_names_) {}
 
-DataNames::DataNames(DataNames&& other)
+DataNames::DataNames(DataNames&& other) MAIDSAFE_NOEXCEPT
     : data_names_(std::move(other.data_names_)) {}
 
 DataNames& DataNames::operator=(DataNames other) {
@@ -174,21 +204,15 @@ DataNames::DataNames(const std::string& serialised_copy)
   protobuf::DataNames proto_copy;
   if (!proto_copy.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
-  for (int index(0); index < proto_copy.data_names_size(); ++index) {
-    data_names_.push_back(DataName(static_cast<DataTagValue>(proto_copy.data_names(index).type()),
-                                   Identity(proto_copy.data_names(index).raw_name())));
-  }
+  data_names_.reserve(proto_copy.data_names_size());
+  for (int index(0); index < proto_copy.data_names_size(); ++index)
+    data_names_.push_back(ParseDataName(proto_copy.data_names(index)));
 }
 
 std::string DataNames::Serialise() const {
   protobuf::DataNames proto_data_names;
-  for (const auto& data_name : data_names_) {
-    protobuf::DataName proto_data_name;
-    proto_data_name.set_type(static_cast<uint32_t>(data_name.type));
-    proto_data_name.set_raw_name(data_name.raw_name.string());
-    auto value(proto_data_names.add_data_names());
-    *value = proto_data_name;
-  }
+  for (const auto& data_name : data_names_)
+    SetDataName(data_name, proto_data_names.add_data_names());
   return proto_data_names.SerializeAsString();
 }
 
@@ -219,7 +243,7 @@ DataNameAndVersion::DataNameAndVersion(const DataName& data_name_in,
 DataNameAndVersion::DataNameAndVersion(const DataNameAndVersion& other)
     : data_name(other.data_name), version_name(other.version_name) {}
 
-DataNameAndVersion::DataNameAndVersion(DataNameAndVersion&& other)
+DataNameAndVersion::DataNameAndVersion(DataNameAndVersion&& other) MAIDSAFE_NOEXCEPT
     : data_name(std::move(other.data_name)), version_name(std::move(other.version_name)) {}
 
 DataNameAndVersion& DataNameAndVersion::operator=(DataNameAndVersion other) {
@@ -232,13 +256,13 @@ DataNameAndVersion::DataNameAndVersion(const std::string& serialised_copy)
   protobuf::DataNameAndVersion proto_copy;
   if (!proto_copy.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
-  data_name = DataName(proto_copy.serialised_data_name());
+  data_name = ParseDataName(proto_copy.data_name());
   version_name = StructuredDataVersions::VersionName(proto_copy.serialised_version_name());
 }
 
 std::string DataNameAndVersion::Serialise() const {
   protobuf::DataNameAndVersion proto_copy;
-  proto_copy.set_serialised_data_name(data_name.Serialise());
+  SetDataName(data_name, proto_copy.mutable_data_name());
   proto_copy.set_serialised_version_name(version_name.Serialise());
   return proto_copy.SerializeAsString();
 }
@@ -253,6 +277,58 @@ void swap(DataNameAndVersion& lhs, DataNameAndVersion& rhs) MAIDSAFE_NOEXCEPT {
   swap(lhs.version_name, rhs.version_name);
 }
 
+// ==================== DataNameVersionAndLimit ====================================================
+
+DataNameVersionAndLimit::DataNameVersionAndLimit() : data_name(), version_name(), limit(0) {}
+
+DataNameVersionAndLimit::DataNameVersionAndLimit(
+    const DataName& data_name_in, const StructuredDataVersions::VersionName& version_name_in,
+    uint32_t limit_in)
+        : data_name(data_name_in), version_name(version_name_in), limit(limit_in) {}
+
+DataNameVersionAndLimit::DataNameVersionAndLimit(const DataNameVersionAndLimit& other)
+    : data_name(other.data_name), version_name(other.version_name), limit(other.limit) {}
+
+DataNameVersionAndLimit::DataNameVersionAndLimit(DataNameVersionAndLimit&& other) MAIDSAFE_NOEXCEPT
+    : data_name(std::move(other.data_name)), version_name(std::move(other.version_name)),
+      limit(other.limit) {}
+
+DataNameVersionAndLimit& DataNameVersionAndLimit::operator=(DataNameVersionAndLimit other) {
+  swap(*this, other);
+  return *this;
+}
+
+DataNameVersionAndLimit::DataNameVersionAndLimit(const std::string& serialised_copy)
+    : data_name(), version_name(), limit(0) {
+  protobuf::DataNameVersionAndLimit proto_copy;
+  if (!proto_copy.ParseFromString(serialised_copy))
+    BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
+  data_name = ParseDataName(proto_copy.data_name());
+  version_name = StructuredDataVersions::VersionName(proto_copy.serialised_version_name());
+  limit = proto_copy.limit();
+}
+
+std::string DataNameVersionAndLimit::Serialise() const {
+  protobuf::DataNameVersionAndLimit proto_copy;
+  SetDataName(data_name, proto_copy.mutable_data_name());
+  proto_copy.set_serialised_version_name(version_name.Serialise());
+  if (limit != 0)
+    proto_copy.set_limit(limit);
+  return proto_copy.SerializeAsString();
+}
+
+bool operator==(const DataNameVersionAndLimit& lhs, const DataNameVersionAndLimit& rhs) {
+  return lhs.data_name == rhs.data_name && lhs.version_name == rhs.version_name &&
+         lhs.limit == rhs.limit;
+}
+
+void swap(DataNameVersionAndLimit& lhs, DataNameVersionAndLimit& rhs) MAIDSAFE_NOEXCEPT {
+  using std::swap;
+  swap(lhs.data_name, rhs.data_name);
+  swap(lhs.version_name, rhs.version_name);
+  swap(lhs.limit, rhs.limit);
+}
+
 // ==================== DataNameOldNewVersion ======================================================
 
 DataNameOldNewVersion::DataNameOldNewVersion()
@@ -269,7 +345,7 @@ DataNameOldNewVersion::DataNameOldNewVersion(const DataNameOldNewVersion& other)
       old_version_name(other.old_version_name),
       new_version_name(other.new_version_name) {}
 
-DataNameOldNewVersion::DataNameOldNewVersion(DataNameOldNewVersion&& other)
+DataNameOldNewVersion::DataNameOldNewVersion(DataNameOldNewVersion&& other) MAIDSAFE_NOEXCEPT
     : data_name(std::move(other.data_name)),
       old_version_name(std::move(other.old_version_name)),
       new_version_name(std::move(other.new_version_name)) {}
@@ -284,7 +360,7 @@ DataNameOldNewVersion::DataNameOldNewVersion(const std::string& serialised_copy)
   protobuf::DataNameOldNewVersion proto_copy;
   if (!proto_copy.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
-  data_name = DataName(proto_copy.serialised_data_name());
+  data_name = ParseDataName(proto_copy.data_name());
   if (proto_copy.has_serialised_old_version_name())
     old_version_name = StructuredDataVersions::VersionName(
                            proto_copy.serialised_old_version_name());
@@ -293,7 +369,7 @@ DataNameOldNewVersion::DataNameOldNewVersion(const std::string& serialised_copy)
 
 std::string DataNameOldNewVersion::Serialise() const {
   protobuf::DataNameOldNewVersion proto_copy;
-  proto_copy.set_serialised_data_name(data_name.Serialise());
+  SetDataName(data_name, proto_copy.mutable_data_name());
   if (old_version_name.id->IsInitialised())
     proto_copy.set_serialised_old_version_name(old_version_name.Serialise());
   proto_copy.set_serialised_new_version_name(new_version_name.Serialise());
@@ -324,7 +400,7 @@ VersionTreeCreation::VersionTreeCreation(const VersionTreeCreation& other)
     : data_name(other.data_name), version_name(other.version_name),
       max_versions(other.max_versions), max_branches(other.max_branches) {}
 
-VersionTreeCreation::VersionTreeCreation(VersionTreeCreation&& other)
+VersionTreeCreation::VersionTreeCreation(VersionTreeCreation&& other) MAIDSAFE_NOEXCEPT
     : data_name(std::move(other.data_name)), version_name(std::move(other.version_name)),
       max_versions(std::move(other.max_versions)), max_branches(std::move(other.max_branches)) {}
 
@@ -338,7 +414,7 @@ VersionTreeCreation::VersionTreeCreation(const std::string& serialised_copy)
   protobuf::VersionTreeCreation proto_copy;
   if (!proto_copy.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
-  data_name = DataName(proto_copy.serialised_data_name());
+  data_name = ParseDataName(proto_copy.data_name());
   version_name = StructuredDataVersions::VersionName(proto_copy.serialised_version_name());
   max_versions = proto_copy.max_versions();
   max_branches = proto_copy.max_branches();
@@ -346,7 +422,7 @@ VersionTreeCreation::VersionTreeCreation(const std::string& serialised_copy)
 
 std::string VersionTreeCreation::Serialise() const {
   protobuf::VersionTreeCreation proto_copy;
-  proto_copy.set_serialised_data_name(data_name.Serialise());
+  SetDataName(data_name, proto_copy.mutable_data_name());
   proto_copy.set_serialised_version_name(version_name.Serialise());
   proto_copy.set_max_versions(max_versions);
   proto_copy.set_max_branches(max_branches);
@@ -371,14 +447,17 @@ void swap(VersionTreeCreation& lhs, VersionTreeCreation& rhs) MAIDSAFE_NOEXCEPT
 
 DataNameAndContent::DataNameAndContent(DataTagValue type_in, const Identity& name_in,
                                        NonEmptyString content_in)
-    : name(type_in, name_in), content(std::move(content_in)) {}
+    : name(type_in, name_in), content(content_in) {}
+
+DataNameAndContent::DataNameAndContent(DataName name_in, nfs::SharedBuffer content_in)
+    : name(std::move(name_in)), content(std::move(content_in)) {}
 
 DataNameAndContent::DataNameAndContent() : name(), content() {}
 
 DataNameAndContent::DataNameAndContent(const DataNameAndContent& other)
     : name(other.name), content(other.content) {}
 
-DataNameAndContent::DataNameAndContent(DataNameAndContent&& other)
+DataNameAndContent::DataNameAndContent(DataNameAndContent&& other) MAIDSAFE_NOEXCEPT
     : name(std::move(other.name)), content(std::move(other.content)) {}
 
 DataNameAndContent& DataNameAndContent::operator=(DataNameAndContent other) {
@@ -390,14 +469,12 @@ DataNameAndContent::DataNameAndContent(const std::string& serialised_copy) : nam
   protobuf::DataNameAndContent proto_copy;
   if (!proto_copy.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
-  name = DataName(proto_copy.serialised_name());
-  content = NonEmptyString(proto_copy.content());
+  *this = ParseDataNameAndContent(proto_copy);
 }
 
 std::string DataNameAndContent::Serialise() const {
   protobuf::DataNameAndContent proto_copy;
-  proto_copy.set_serialised_name(name.Serialise());
-  proto_copy.set_content(content.string());
+  SetDataNameAndContent(*this, &proto_copy);
   return proto_copy.SerializeAsString();
 }
 
@@ -415,18 +492,63 @@ void swap(DataNameAndContent& lhs, DataNameAndContent& rhs) MAIDSAFE_NOEXCEPT {
   swap(lhs.name, rhs.name);
   swap(lhs.content, rhs.content);
 }
+// ========================== DataNamesAndContents =================================================
+
+DataNamesAndContents::DataNamesAndContents() : data() {}
+
+DataNamesAndContents::DataNamesAndContents(std::vector<DataNameAndContent> data_in)
+    : data(std::move(data_in)) {}
+
+DataNamesAndContents::DataNamesAndContents(const DataNamesAndContents& other)
+    : data(other.data) {}
+
+DataNamesAndContents::DataNamesAndContents(DataNamesAndContents&& other) MAIDSAFE_NOEXCEPT
+    : data(std::move(other.data)) {}
+
+DataNamesAndContents& DataNamesAndContents::operator=(DataNamesAndContents other) {
+  swap(*this, other);
+  return *this;
+}
+
+DataNamesAndContents::DataNamesAndContents(const std::string& serialised_copy) : data() {
+  protobuf::DataNamesAndContents proto_copy;
+  if (!proto_copy.ParseFromString(serialised_copy))
+    BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
+  data.reserve(proto_copy.data_size());
+  for (int index(0); index < proto_copy.data_size(); ++index)
+    data.push_back(ParseDataNameAndContent(*proto_copy.mutable_data(index)));
+}
+
+std::string DataNamesAndContents::Serialise() const {
+  protobuf::DataNamesAndContents proto_copy;
+  for (const auto& data_name_and_content : data)
+    SetDataNameAndContent(data_name_and_content, proto_copy.add_data());
+  return proto_copy.SerializeAsString();
+}
+
+bool operator==(const DataNamesAndContents& lhs, const DataNamesAndContents& rhs) {
+  return lhs.data == rhs.data;
+}
+
+void swap(DataNamesAndContents& lhs, DataNamesAndContents& rhs) MAIDSAFE_NOEXCEPT {
+  using std::swap;
+  swap(lhs.data, rhs.data);
+}
+
 // ========================== Content ==============================================================
 
 Content::Content(const std::string &data_in) : data(data_in) {}
 
+Content::Content(nfs::SharedBuffer data_in) : data(std::move(data_in)) {}
+
 Content::Content() : data() {}
 
 Content::Content(const Content& other) : data(other.data) {}
 
-Content::Content(Content&& other) : data(std::move(other.data)) {}
+Content::Content(Content&& other) MAIDSAFE_NOEXCEPT : data(std::move(other.data)) {}
 
 std::string Content::Serialise() const {
-  return data;
+  return data.IsInitialised() ? data.string() : std::string();
 }
 
 Content& Content::operator=(Content other) {
@@ -454,7 +576,7 @@ DataNameAndRandomString::DataNameAndRandomString() : name(), random_string() {}
 DataNameAndRandomString::DataNameAndRandomString(const DataNameAndRandomString& other)
     : name(other.name), random_string(other.random_string) {}
 
-DataNameAndRandomString::DataNameAndRandomString(DataNameAndRandomString&& other)
+DataNameAndRandomString::DataNameAndRandomString(DataNameAndRandomString&& other) MAIDSAFE_NOEXCEPT
     : name(std::move(other.name)), random_string(std::move(other.random_string)) {}
 
 DataNameAndRandomString& DataNameAndRandomString::operator=(DataNameAndRandomString other) {
@@ -467,13 +589,13 @@ DataNameAndRandomString::DataNameAndRandomString(const std::string& serialised_c
   protobuf::DataNameAndRandomString proto_copy;
   if (!proto_copy.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
-  name = DataName(proto_copy.serialised_name());
+  name = ParseDataName(proto_copy.name());
   random_string = NonEmptyString(proto_copy.random_string());
 }
 
 std::string DataNameAndRandomString::Serialise() const {
   protobuf::DataNameAndRandomString proto_copy;
-  proto_copy.set_serialised_name(name.Serialise());
+  SetDataName(name, proto_copy.mutable_name());
   proto_copy.set_random_string(random_string.string());
   return proto_copy.SerializeAsString();
 }
@@ -498,7 +620,7 @@ DataNameAndCost::DataNameAndCost(DataTagValue type_in, const Identity& name_in,
 DataNameAndCost::DataNameAndCost(const DataNameAndCost& other)
     : name(other.name), cost(other.cost) {}
 
-DataNameAndCost::DataNameAndCost(DataNameAndCost&& other)
+DataNameAndCost::DataNameAndCost(DataNameAndCost&& other) MAIDSAFE_NOEXCEPT
     : name(std::move(other.name)), cost(std::move(other.cost)) {}
 
 DataNameAndCost& DataNameAndCost::operator=(DataNameAndCost other) {
@@ -510,13 +632,13 @@ DataNameAndCost::DataNameAndCost(const std::string& serialised_copy) : name(), c
   protobuf::DataNameAndCost proto_copy;
   if (!proto_copy.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
-  name = DataName(proto_copy.serialised_name());
+  name = ParseDataName(proto_copy.name());
   cost = proto_copy.cost();
 }
 
 std::string DataNameAndCost::Serialise() const {
   protobuf::DataNameAndCost proto_copy;
-  proto_copy.set_serialised_name(name.Serialise());
+  SetDataName(name, proto_copy.mutable_name());
   proto_copy.set_cost(cost);
   return proto_copy.SerializeAsString();
 }
@@ -541,7 +663,7 @@ DataNameAndSize::DataNameAndSize(DataTagValue type_in, const Identity& name_in,
 DataNameAndSize::DataNameAndSize(const DataNameAndSize& other)
     : name(other.name), size(other.size) {}
 
-DataNameAndSize::DataNameAndSize(DataNameAndSize&& other)
+DataNameAndSize::DataNameAndSize(DataNameAndSize&& other) MAIDSAFE_NOEXCEPT
     : name(std::move(other.name)), size(std::move(other.size)) {}
 
 DataNameAndSize& DataNameAndSize::operator=(DataNameAndSize other) {
@@ -553,13 +675,13 @@ DataNameAndSize::DataNameAndSize(const std::string& serialised_copy) : name(), s
   protobuf::DataNameAndSize proto_copy;
   if (!proto_copy.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
-  name = DataName(proto_copy.serialised_name());
+  name = ParseDataName(proto_copy.name());
   size = proto_copy.size();
 }
 
 std::string DataNameAndSize::Serialise() const {
   protobuf::DataNameAndSize proto_copy;
-  proto_copy.set_serialised_name(name.Serialise());
+  SetDataName(name, proto_copy.mutable_name());
   proto_copy.set_size(size);
   return proto_copy.SerializeAsString();
 }
@@ -588,7 +710,7 @@ DataNameAndContentOrCheckResult::DataNameAndContentOrCheckResult()
     : name(), content(), check_result() {}
 
 DataNameAndContentOrCheckResult::DataNameAndContentOrCheckResult(
-    DataNameAndContentOrCheckResult&& other)
+    DataNameAndContentOrCheckResult&& other) MAIDSAFE_NOEXCEPT
         : name(std::move(other.name)),
           content(std::move(other.content)),
           check_result(std::move(other.check_result)) {}
@@ -611,7 +733,7 @@ DataNameAndContentOrCheckResult::DataNameAndContentOrCheckResult(
   if (!proto.ParseFromString(serialised_copy))
     BOOST_THROW_EXCEPTION(MakeError(CommonErrors::parsing_error));
 
-  name = DataName(proto.serialised_name());
+  name = ParseDataName(proto.name());
   if (proto.has_content())
     content.reset(NonEmptyString(proto.content()));
   if (proto.has_check_result())
@@ -625,7 +747,7 @@ DataNameAndContentOrCheckResult::DataNameAndContentOrCheckResult(
 
 std::string DataNameAndContentOrCheckResult::Serialise() const {
   protobuf::DataNameAndContentOrCheckResult proto;
-  proto.set_serialised_name(name.Serialise());
+  SetDataName(name, proto.mutable_name());
   if (content)
     proto.set_content(content->string());
   if (check_result)
@@ -673,7 +795,7 @@ PmidHealth::PmidHealth(const std::string& serialised_copy)
 PmidHealth::PmidHealth(const PmidHealth& other)
     : serialised_pmid_health(other.serialised_pmid_health) {}
 
-PmidHealth::PmidHealth(PmidHealth&& other)
+PmidHealth::PmidHealth(PmidHealth&& other) MAIDSAFE_NOEXCEPT
     : serialised_pmid_health(std::move(other.serialised_pmid_health)) {}
 
 PmidHealth& PmidHealth::operator=(PmidHealth other) {